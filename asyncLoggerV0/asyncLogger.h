@@ -0,0 +1,265 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Asynchronous logger: keeps terminal I/O out of critical sections.
+//
+//   alog::log("[Producer {}] produced: {}", id, item);
+//
+// log() copies the format pointer and the raw argument values into a
+// fixed-size record in the calling thread's own ring buffer (no lock, no
+// allocation, no formatting). A background thread drains every ring, sorts
+// the records by timestamp, substitutes the "{}" placeholders and writes
+// them to stdout.
+//
+// Rules of use:
+//   - the format string and any `const char*` argument must outlive the
+//     logger (string literals); std::string arguments are not accepted
+//   - at most kMaxArgs arguments: integers, floating point, char, const char*
+//   - if a thread's ring is full the record is dropped and counted, the hot
+//     path never blocks on the flusher
+//   - a thread's first log() takes a ring (from the free list if one is
+//     there, else a new allocation); once the thread exits and the flusher
+//     has drained its ring, the ring goes back on the free list, so programs
+//     that keep starting short-lived threads reuse a bounded set of rings
+namespace alog {
+
+constexpr int kMaxArgs = 6;
+constexpr std::size_t kRingSize = 1024;  // records per thread, power of two (~120 KB)
+
+struct Arg {
+    enum Kind : std::uint8_t { Int, UInt, Double, Char, Str };
+    Kind kind;
+    union {
+        std::int64_t i;
+        std::uint64_t u;
+        double d;
+        char c;
+        const char* s;
+    };
+};
+
+struct Record {
+    std::int64_t ts_ns;
+    const char* fmt;
+    std::uint8_t nargs;
+    Arg args[kMaxArgs];
+};
+
+template <typename T>
+Arg make_arg(T v) {
+    Arg a;
+    if constexpr (std::is_same_v<T, char>) {
+        a.kind = Arg::Char;
+        a.c = v;
+    } else if constexpr (std::is_same_v<T, bool>) {
+        a.kind = Arg::Str;
+        a.s = v ? "true" : "false";
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+        a.kind = Arg::Int;
+        a.i = v;
+    } else if constexpr (std::is_integral_v<T>) {
+        a.kind = Arg::UInt;
+        a.u = v;
+    } else if constexpr (std::is_floating_point_v<T>) {
+        a.kind = Arg::Double;
+        a.d = v;
+    } else {
+        static_assert(std::is_same_v<T, const char*> || std::is_same_v<T, char*>,
+                      "alog arguments must be arithmetic or string literals");
+        a.kind = Arg::Str;
+        a.s = v;
+    }
+    return a;
+}
+
+// Single-producer (the owning thread) / single-consumer (the flusher) ring.
+// The flusher polls, so unlike SpscRingBuffer there is no wakeup machinery.
+class ThreadBuffer {
+public:
+    bool try_push(const Record& r) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == kRingSize) return false;
+        slots_[tail & (kRingSize - 1)] = r;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <typename Out>
+    void drain(Out& out) {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        const std::size_t tail = tail_.load(std::memory_order_acquire);
+        for (; head != tail; ++head) out.push_back(slots_[head & (kRingSize - 1)]);
+        head_.store(head, std::memory_order_release);
+    }
+
+    bool empty() const {
+        return head_.load(std::memory_order_relaxed) == tail_.load(std::memory_order_acquire);
+    }
+
+    std::atomic<std::uint64_t> dropped{0};
+    std::atomic<bool> exited{false};  // owning thread is gone; set with release
+    bool free = false;                // on the free list (Logger::buffers_mtx_)
+
+private:
+    alignas(64) std::atomic<std::size_t> head_{0};
+    alignas(64) std::atomic<std::size_t> tail_{0};
+    alignas(64) Record slots_[kRingSize];
+};
+
+class Logger {
+public:
+    static Logger& instance() {
+        static Logger logger;
+        return logger;
+    }
+
+    ~Logger() {
+        running_.store(false, std::memory_order_release);
+        if (flusher_.joinable()) flusher_.join();
+        flush_once();
+    }
+
+    template <typename... Args>
+    void log(const char* fmt, Args... args) {
+        static_assert(sizeof...(Args) <= kMaxArgs, "too many alog arguments");
+        Record r;
+        r.ts_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now().time_since_epoch()).count();
+        r.fmt = fmt;
+        r.nargs = sizeof...(Args);
+        int i = 0;
+        ((r.args[i++] = make_arg(args)), ...);
+        ThreadBuffer& buf = local_buffer();
+        if (!buf.try_push(r)) buf.dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Blocks until everything logged before the call has been written.
+    void flush() {
+        std::lock_guard<std::mutex> lock(flush_mtx_);
+        flush_once_locked();
+    }
+
+private:
+    Logger() : flusher_([this] { run(); }) {}
+
+    // Marks the ring as orphaned when its thread exits; the flusher drains
+    // what is left and then recycles it.
+    struct LocalBuffer {
+        ThreadBuffer* buf;
+        ~LocalBuffer() { buf->exited.store(true, std::memory_order_release); }
+    };
+
+    ThreadBuffer& local_buffer() {
+        thread_local LocalBuffer local{register_thread()};
+        return *local.buf;
+    }
+
+    // Cold path, once per thread: reuse a drained ring of an exited thread,
+    // else allocate one. Rings live as long as the logger.
+    ThreadBuffer* register_thread() {
+        std::lock_guard<std::mutex> lock(buffers_mtx_);
+        if (!free_.empty()) {
+            ThreadBuffer* buf = free_.back();
+            free_.pop_back();
+            buf->free = false;
+            buf->exited.store(false, std::memory_order_relaxed);
+            return buf;
+        }
+        buffers_.push_back(std::make_unique<ThreadBuffer>());
+        return buffers_.back().get();
+    }
+
+    void run() {
+        while (running_.load(std::memory_order_acquire)) {
+            if (flush_once() == 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    std::size_t flush_once() {
+        std::lock_guard<std::mutex> lock(flush_mtx_);
+        return flush_once_locked();
+    }
+
+    std::size_t flush_once_locked() {
+        batch_.clear();
+        std::uint64_t dropped = 0;
+        {
+            std::lock_guard<std::mutex> lock(buffers_mtx_);
+            for (auto& b : buffers_) {
+                if (b->free) continue;
+                // Read `exited` first: every record of an exited thread is
+                // visible by then, so an empty ring after drain() is done.
+                const bool exited = b->exited.load(std::memory_order_acquire);
+                b->drain(batch_);
+                dropped += b->dropped.exchange(0, std::memory_order_relaxed);
+                if (exited && b->empty()) {
+                    b->free = true;
+                    free_.push_back(b.get());
+                }
+            }
+        }
+        std::stable_sort(batch_.begin(), batch_.end(),
+                         [](const Record& a, const Record& b) { return a.ts_ns < b.ts_ns; });
+        for (const Record& r : batch_) write(r);
+        if (dropped != 0) std::fprintf(stdout, "[alog] dropped %llu records\n", (unsigned long long)dropped);
+        std::fflush(stdout);
+        return batch_.size();
+    }
+
+    void write(const Record& r) {
+        line_.clear();
+        int next = 0;
+        for (const char* p = r.fmt; *p; ++p) {
+            if (p[0] == '{' && p[1] == '}' && next < r.nargs) {
+                append(r.args[next++]);
+                ++p;
+            } else {
+                line_ += *p;
+            }
+        }
+        std::fwrite(line_.data(), 1, line_.size(), stdout);
+    }
+
+    void append(const Arg& a) {
+        char tmp[32];
+        switch (a.kind) {
+            case Arg::Int: std::snprintf(tmp, sizeof(tmp), "%lld", (long long)a.i); break;
+            case Arg::UInt: std::snprintf(tmp, sizeof(tmp), "%llu", (unsigned long long)a.u); break;
+            case Arg::Double: std::snprintf(tmp, sizeof(tmp), "%g", a.d); break;
+            case Arg::Char: line_ += a.c; return;
+            case Arg::Str: line_ += a.s ? a.s : "(null)"; return;
+        }
+        line_ += tmp;
+    }
+
+    std::mutex buffers_mtx_;  // guards buffers_ and free_ (registration is rare)
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+    std::vector<ThreadBuffer*> free_;  // drained rings of exited threads
+
+    std::mutex flush_mtx_;  // one drainer at a time: flusher or flush()
+    std::vector<Record> batch_;
+    std::string line_;
+
+    std::atomic<bool> running_{true};
+    std::thread flusher_;
+};
+
+template <typename... Args>
+inline void log(const char* fmt, Args... args) {
+    Logger::instance().log(fmt, args...);
+}
+
+inline void flush() { Logger::instance().flush(); }
+
+}  // namespace alog
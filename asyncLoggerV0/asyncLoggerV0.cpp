@@ -0,0 +1,62 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "asyncLogger.h"
+
+// Lock hold time with std::cout inside the critical section vs alog::log.
+//
+// Same shape as tas_critical_section in casTasV0/tasV0.cpp: take a TAS
+// spinlock, print, release. The log lines go to stdout and the summary to
+// stderr, so run it as `./asyncLoggerV0 > /dev/null` (or into a file) to
+// see the numbers without the terminal in the way.
+
+std::atomic_flag tas_lock = ATOMIC_FLAG_INIT;
+
+using Clock = std::chrono::steady_clock;
+
+template <typename Print>
+double avg_hold_ns(int threads, int iterations, Print print) {
+    std::atomic<long long> total_ns{0};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            long long local = 0;
+            for (int i = 0; i < iterations; ++i) {
+                while (tas_lock.test_and_set(std::memory_order_acquire)) {
+                }
+                auto start = Clock::now();
+                print(t, i);
+                local += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+                tas_lock.clear(std::memory_order_release);
+            }
+            total_ns += local;
+        });
+    }
+    for (auto& w : workers) w.join();
+    return static_cast<double>(total_ns) / (static_cast<double>(threads) * iterations);
+}
+
+// ./asyncLoggerV0 [threads] [iterations]
+int main(int argc, char** argv) {
+    int threads = argc > 1 ? std::atoi(argv[1]) : 4;
+    int iterations = argc > 2 ? std::atoi(argv[2]) : 2000;
+
+    double cout_ns = avg_hold_ns(threads, iterations, [](int id, int i) {
+        std::cout << "[TAS] Thread " << id << " in critical section, iteration " << i << "\n";
+    });
+    std::cout.flush();
+
+    double alog_ns = avg_hold_ns(threads, iterations, [](int id, int i) {
+        alog::log("[TAS] Thread {} in critical section, iteration {}\n", id, i);
+    });
+    alog::flush();
+
+    std::cerr << threads << " threads x " << iterations << " iterations\n";
+    std::cerr << "avg lock hold with std::cout: " << cout_ns << " ns\n";
+    std::cerr << "avg lock hold with alog::log: " << alog_ns << " ns\n";
+    return 0;
+}
@@ -2,6 +2,8 @@
 #include <iostream>
 #include <thread>
 
+#include "contention.h"
+
 //std::atomic<int> counter = 0;
 std::atomic<int> counter{0};
 
@@ -9,11 +11,15 @@ void cas_increment(int id) {
     for (int i = 0; i < 5; ++i) {
         int expected;
         int desired;
-        do {
-            expected = counter.load();
+        CONTENTION_PROBE(probe, "cas_increment", CasFailures);
+        expected = counter.load();
+        for (;;) {
             desired = expected + 1;
-        } while (!counter.compare_exchange_weak(expected, desired));
-        
+            if (counter.compare_exchange_weak(expected, desired)) break;
+            CONTENTION_CAS_FAIL(probe);  // expected now holds the current value
+        }
+        CONTENTION_ACQUIRED(probe);
+
         std::cout << "[CAS] Thread " << id << " incremented counter to " << desired << "\n";
         std::this_thread::sleep_for(std::chrono::milliseconds(50));
     }
@@ -27,6 +33,7 @@ int main() {
     t2.join();
 
     std::cout << "Final counter: " << counter << "\n";
+    CONTENTION_REPORT(std::cout);  // only with -DCONTENTION_STATS
     return 0;
 }
 
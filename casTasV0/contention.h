@@ -0,0 +1,133 @@
+#pragma once
+
+// Opt-in contention statistics for the CAS / TAS loops.
+//
+// cas_increment and tas_critical_section do not say how often the
+// compare_exchange_weak loop retries or how long test_and_set spins, so a
+// slowdown cannot be told apart from contention. Build with
+// -DCONTENTION_STATS and each instrumented acquisition records, per thread:
+//   cas failures   failed compare_exchange attempts before success
+//   spins          failed test_and_set / wait iterations before success
+//   acquire ns     time from the first attempt to success
+// into per-thread log2-bucket histograms (threadHistogram.h);
+// CONTENTION_REPORT merges all live and exited threads on demand. Each site
+// names the retry count it instruments, and the report always prints that
+// row and acquire ns, zeros included: "0 cas failures" is an answer.
+//
+//   void cas_increment() {
+//       CONTENTION_PROBE(probe, "cas_increment", CasFailures);   // or Spins
+//       while (!counter.compare_exchange_weak(expected, desired)) CONTENTION_CAS_FAIL(probe);
+//       CONTENTION_ACQUIRED(probe);
+//   }
+//   ...
+//   CONTENTION_REPORT(std::cout);
+//
+// Without CONTENTION_STATS every macro expands to nothing: no probe object,
+// no clock read, no thread_local, so release builds pay nothing.
+
+#if defined(CONTENTION_STATS)
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <string>
+
+#include "threadHistogram.h"
+
+namespace contention {
+
+const int kMaxSites = 16;
+
+enum Metric { kCasFailures, kSpins, kAcquireNs, kMetrics };
+
+inline const char* metric_name(int m) {
+    static const char* const names[kMetrics] = {"cas failures", "spins", "acquire ns"};
+    return names[m];
+}
+
+struct SiteStats {
+    threadhist::Histogram h[kMetrics];
+    void merge(const SiteStats& o) {
+        for (int m = 0; m < kMetrics; ++m) h[m].merge(o.h[m]);
+    }
+};
+
+typedef threadhist::SiteRegistry<SiteStats, kMaxSites> Sites;
+
+// Per site: bit m set if the site instruments metric m.
+inline std::atomic<unsigned>* site_metrics() {
+    static std::atomic<unsigned> masks[kMaxSites];  // zero-initialized: static storage
+    return masks;
+}
+
+// Returns the id for `name`, registering it on first use, and marks
+// `counted` (kCasFailures or kSpins) and kAcquireNs as instrumented there.
+inline int site(const char* name, Metric counted) {
+    const int s = Sites::instance().site(name);
+    site_metrics()[s].fetch_or((1u << counted) | (1u << kAcquireNs), std::memory_order_relaxed);
+    return s;
+}
+
+// One acquisition attempt at a site.
+class Probe {
+public:
+    explicit Probe(int site) : site_(site), start_(std::chrono::steady_clock::now()) {}
+
+    void cas_fail() { ++cas_failures_; }
+    void spin() { ++spins_; }
+
+    void acquired() {
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_);
+        threadhist::Histogram* h = Sites::instance().local(site_).h;
+        h[kCasFailures].record(cas_failures_);
+        h[kSpins].record(spins_);
+        h[kAcquireNs].record(static_cast<std::uint64_t>(ns.count()));
+    }
+
+private:
+    int site_;
+    std::chrono::steady_clock::time_point start_;
+    std::uint64_t cas_failures_ = 0;
+    std::uint64_t spins_ = 0;
+};
+
+// Merges every thread's histograms and prints one line per site and
+// instrumented metric, even if it stayed 0.
+inline void report(std::ostream& os) {
+    os << "site\tmetric\tcount\tmean\tp50<=\tp99<=\tmax\n";
+    int s = 0;  // for_each_site visits sites in id order
+    Sites::instance().for_each_site([&os, &s](const std::string& name, const SiteStats& total) {
+        const unsigned metrics = site_metrics()[s++].load(std::memory_order_relaxed);
+        for (int m = 0; m < kMetrics; ++m) {
+            if (!(metrics & (1u << m))) continue;
+            const threadhist::Histogram& h = total.h[m];
+            const std::uint64_t n = h.count.load(std::memory_order_relaxed);
+            os << name << "\t" << metric_name(m) << "\t" << n << "\t" << std::fixed << std::setprecision(2)
+               << h.mean() << std::defaultfloat << "\t" << h.quantile(0.50) << "\t" << h.quantile(0.99) << "\t"
+               << h.max.load(std::memory_order_relaxed) << "\n";
+        }
+    });
+}
+
+}  // namespace contention
+
+// `counted` is CasFailures or Spins.
+#define CONTENTION_PROBE(probe, name, counted)                                       \
+    static const int probe##_site = ::contention::site(name, ::contention::k##counted); \
+    ::contention::Probe probe(probe##_site)
+#define CONTENTION_CAS_FAIL(probe) probe.cas_fail()
+#define CONTENTION_SPIN(probe) probe.spin()
+#define CONTENTION_ACQUIRED(probe) probe.acquired()
+#define CONTENTION_REPORT(os) ::contention::report(os)
+
+#else
+
+#define CONTENTION_PROBE(probe, name, counted)
+#define CONTENTION_CAS_FAIL(probe) ((void)0)
+#define CONTENTION_SPIN(probe) ((void)0)
+#define CONTENTION_ACQUIRED(probe) ((void)0)
+#define CONTENTION_REPORT(os) ((void)0)
+
+#endif
@@ -0,0 +1,354 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "../producerConsumerV0/cacheLine.h"
+
+// Safe memory reclamation for lock-free containers.
+//
+// A thread that unlinks a node with compare_exchange_weak (as in casV0.cpp)
+// cannot delete it right away: another thread may have loaded the old
+// pointer and be about to dereference it. Both domains below defer the
+// delete until no reader can still hold the pointer, behind one API:
+//
+//   reclaim::EpochDomain domain;          // or reclaim::HazardDomain
+//   std::atomic<Node*> head;
+//
+//   // reader
+//   {
+//       reclaim::EpochDomain::Guard g(domain);
+//       Node* n = g.protect(0, head);     // safe to dereference until g dies
+//       use(n->value);
+//   }
+//   // writer, after unlinking `old`
+//   domain.retire(old);                   // deleted once no guard can see it
+//
+//   HazardDomain (Michael 2004): protect() publishes the pointer in one of
+//     the thread's kHazardsPerThread slots and re-checks the source.
+//     Readers pay a store + full fence per pointer; unreclaimed memory is
+//     bounded even if a reader stalls (it pins only what it protects).
+//   EpochDomain (Fraser 2004): a guard announces the global epoch once;
+//     protect() is a plain acquire load. Nodes retired in epoch e are freed
+//     once every active thread has been seen in e + 2. Cheapest reads, but
+//     one stalled reader holds back everything retired after it.
+//
+// Frees are batched: retire() only appends to the calling thread's list,
+// and every kRetireBatch retires the thread scans (hazards) or tries to
+// advance the epoch, then frees everything that became safe in one go.
+//
+// Per-thread state lives in one of kMaxThreads records per domain, claimed
+// on a thread's first use and returned when the thread exits. A HazardDomain
+// thread may hold one Guard at a time; EpochDomain guards nest. Destroying a
+// domain frees everything still retired and requires that no guard is live.
+namespace reclaim {
+
+constexpr int kMaxThreads = 256;
+constexpr int kHazardsPerThread = 4;
+constexpr std::size_t kRetireBatch = 64;
+
+namespace detail {
+
+struct Retired {
+    void* ptr;
+    void (*deleter)(void*);
+    std::uint64_t epoch;  // EpochDomain only
+};
+
+template <typename T>
+void delete_as(void* p) {
+    delete static_cast<T*>(p);
+}
+
+// Ids of domains that are still alive, so a thread exiting after its domain
+// died does not touch freed memory when it hands back its records. Ids are
+// never reused, unlike addresses: a new domain on the stack often lands
+// where the previous one was.
+inline std::mutex& registry_mutex() {
+    static std::mutex m;
+    return m;
+}
+inline std::unordered_set<std::uint64_t>& live_domains() {
+    static std::unordered_set<std::uint64_t> s;
+    return s;
+}
+inline std::uint64_t next_domain_id() {
+    static std::atomic<std::uint64_t> next{1};
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Record slots shared by both domains. Record must have `std::atomic<bool>
+// in_use` and `std::vector<Retired> retired`.
+template <typename Record>
+class Records {
+public:
+    Records() : id_(next_domain_id()) {
+        std::lock_guard<std::mutex> lock(registry_mutex());
+        live_domains().insert(id_);
+    }
+    ~Records() {
+        std::lock_guard<std::mutex> lock(registry_mutex());
+        live_domains().erase(id_);
+    }
+
+    // The calling thread's record, claimed on first use.
+    Record& mine() {
+        Cache& cache = cache_();
+        for (auto& e : cache.entries)
+            if (e.id == id_) return *static_cast<Record*>(e.record);
+        cache.prune();
+        for (int i = 0; i < kMaxThreads; ++i) {
+            bool expected = false;
+            if (!records_[i].in_use.load(std::memory_order_relaxed) &&
+                records_[i].in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                used_.fetch_add(1, std::memory_order_relaxed);
+                int hw = high_water_.load(std::memory_order_relaxed);
+                while (hw < i + 1 && !high_water_.compare_exchange_weak(hw, i + 1, std::memory_order_release)) {
+                }
+                cache.entries.push_back({id_, this, &records_[i]});
+                return records_[i];
+            }
+        }
+        std::abort();  // more than kMaxThreads threads use this domain at once
+    }
+
+    template <typename F>
+    void for_each(F f) {
+        const int n = high_water_.load(std::memory_order_acquire);
+        for (int i = 0; i < n; ++i) f(records_[i]);
+    }
+
+    int threads() const { return used_.load(std::memory_order_relaxed); }
+
+private:
+    // Per thread: which record it holds in each domain. On thread exit the
+    // records go back (their retired lists stay and are drained by the next
+    // owner or the domain destructor).
+    struct Cache {
+        struct Entry {
+            std::uint64_t id;
+            Records* domain;
+            void* record;
+        };
+        std::vector<Entry> entries;
+        // Drops entries of domains that have died (on a cache miss only).
+        void prune() {
+            std::lock_guard<std::mutex> lock(registry_mutex());
+            entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                         [](const Entry& e) { return !live_domains().count(e.id); }),
+                          entries.end());
+        }
+        ~Cache() {
+            std::lock_guard<std::mutex> lock(registry_mutex());
+            for (auto& e : entries) {
+                if (!live_domains().count(e.id)) continue;
+                static_cast<Record*>(e.record)->release();
+                e.domain->used_.fetch_sub(1, std::memory_order_relaxed);
+                static_cast<Record*>(e.record)->in_use.store(false, std::memory_order_release);
+            }
+        }
+    };
+    static Cache& cache_() {
+        thread_local Cache c;
+        return c;
+    }
+
+    const std::uint64_t id_;
+    Record records_[kMaxThreads];
+    std::atomic<int> high_water_{0};
+    std::atomic<int> used_{0};
+};
+
+}  // namespace detail
+
+class HazardDomain {
+    struct Record;
+
+public:
+    HazardDomain() = default;
+    ~HazardDomain() {
+        records_.for_each([&](Record& r) { free_all(r.retired); });
+    }
+    HazardDomain(const HazardDomain&) = delete;
+    HazardDomain& operator=(const HazardDomain&) = delete;
+
+    class Guard {
+    public:
+        explicit Guard(HazardDomain& d) : rec_(d.records_.mine()) {}
+        ~Guard() {
+            for (auto& h : rec_.hazards) h.store(nullptr, std::memory_order_release);
+        }
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+        // Loads `src` and keeps the result alive until the guard dies or
+        // slot `i` is reused.
+        template <typename T>
+        T* protect(int i, const std::atomic<T*>& src) {
+            T* p = src.load(std::memory_order_relaxed);
+            for (;;) {
+                rec_.hazards[i].store(p, std::memory_order_seq_cst);
+                T* again = src.load(std::memory_order_seq_cst);
+                if (again == p) return p;
+                p = again;
+            }
+        }
+
+    private:
+        Record& rec_;
+    };
+
+    template <typename T>
+    void retire(T* p) {
+        Record& r = records_.mine();
+        r.retired.push_back({p, &detail::delete_as<T>, 0});
+        unreclaimed_.fetch_add(1, std::memory_order_relaxed);
+        // Scan once the list outgrows every published hazard, so each scan
+        // frees at least half of what it looks at.
+        const std::size_t threshold =
+            std::max(kRetireBatch, 2 * static_cast<std::size_t>(kHazardsPerThread * records_.threads()));
+        if (r.retired.size() >= threshold) scan(r);
+    }
+
+    // Retired but not yet freed, over all threads.
+    std::size_t unreclaimed() const { return unreclaimed_.load(std::memory_order_relaxed); }
+
+private:
+    struct alignas(kCacheLineSize) Record {
+        std::atomic<bool> in_use{false};
+        std::atomic<void*> hazards[kHazardsPerThread] = {};
+        std::vector<detail::Retired> retired;
+        void release() {
+            for (auto& h : hazards) h.store(nullptr, std::memory_order_release);
+        }
+    };
+
+    void scan(Record& r) {
+        std::vector<void*> hazards;
+        records_.for_each([&](Record& other) {
+            for (auto& h : other.hazards)
+                if (void* p = h.load(std::memory_order_seq_cst)) hazards.push_back(p);
+        });
+        std::sort(hazards.begin(), hazards.end());
+        std::size_t kept = 0;
+        for (auto& x : r.retired) {
+            if (std::binary_search(hazards.begin(), hazards.end(), x.ptr)) r.retired[kept++] = x;
+            else x.deleter(x.ptr);
+        }
+        unreclaimed_.fetch_sub(r.retired.size() - kept, std::memory_order_relaxed);
+        r.retired.resize(kept);
+    }
+
+    void free_all(std::vector<detail::Retired>& list) {
+        for (auto& x : list) x.deleter(x.ptr);
+        unreclaimed_.fetch_sub(list.size(), std::memory_order_relaxed);
+        list.clear();
+    }
+
+    detail::Records<Record> records_;
+    alignas(kCacheLineSize) std::atomic<std::size_t> unreclaimed_{0};
+};
+
+class EpochDomain {
+    struct Record;
+
+public:
+    EpochDomain() = default;
+    ~EpochDomain() {
+        records_.for_each([&](Record& r) {
+            for (auto& x : r.retired) x.deleter(x.ptr);
+            unreclaimed_.fetch_sub(r.retired.size(), std::memory_order_relaxed);
+            r.retired.clear();
+        });
+    }
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    class Guard {
+    public:
+        explicit Guard(EpochDomain& d) : rec_(d.records_.mine()) {
+            if (rec_.nesting++ == 0) {
+                rec_.epoch.store(d.epoch_.load(std::memory_order_relaxed) << 1 | 1, std::memory_order_relaxed);
+                // Announce before any protected load; pairs with the fence in
+                // try_advance().
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+            }
+        }
+        ~Guard() {
+            if (--rec_.nesting == 0) rec_.epoch.store(0, std::memory_order_release);
+        }
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+        template <typename T>
+        T* protect(int, const std::atomic<T*>& src) {
+            return src.load(std::memory_order_acquire);
+        }
+
+    private:
+        Record& rec_;
+    };
+
+    template <typename T>
+    void retire(T* p) {
+        Record& r = records_.mine();
+        // seq_cst: the tag must not be older than the unlink that preceded us.
+        r.retired.push_back({p, &detail::delete_as<T>, epoch_.load(std::memory_order_seq_cst)});
+        unreclaimed_.fetch_add(1, std::memory_order_relaxed);
+        if (++r.since_collect >= kRetireBatch) {
+            r.since_collect = 0;
+            collect(r);
+        }
+    }
+
+    std::size_t unreclaimed() const { return unreclaimed_.load(std::memory_order_relaxed); }
+
+private:
+    struct alignas(kCacheLineSize) Record {
+        std::atomic<bool> in_use{false};
+        std::atomic<std::uint64_t> epoch{0};  // (epoch << 1) | 1 while inside a guard, 0 outside
+        int nesting = 0;
+        std::size_t since_collect = 0;
+        std::vector<detail::Retired> retired;
+        void release() { epoch.store(0, std::memory_order_release); }
+    };
+
+    // Advances the global epoch if every thread inside a guard has seen it.
+    void try_advance() {
+        std::uint64_t e = epoch_.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        bool all_current = true;
+        records_.for_each([&](Record& r) {
+            const std::uint64_t v = r.epoch.load(std::memory_order_relaxed);
+            if ((v & 1) && (v >> 1) != e) all_current = false;
+        });
+        if (all_current) epoch_.compare_exchange_strong(e, e + 1, std::memory_order_acq_rel);
+    }
+
+    // Frees this thread's nodes retired two or more epochs ago: every guard
+    // that could have seen them has ended since.
+    void collect(Record& r) {
+        try_advance();
+        const std::uint64_t e = epoch_.load(std::memory_order_acquire);
+        std::size_t kept = 0;
+        for (auto& x : r.retired) {
+            if (x.epoch + 2 <= e) x.deleter(x.ptr);
+            else r.retired[kept++] = x;
+        }
+        unreclaimed_.fetch_sub(r.retired.size() - kept, std::memory_order_relaxed);
+        r.retired.resize(kept);
+    }
+
+    detail::Records<Record> records_;
+    alignas(kCacheLineSize) std::atomic<std::uint64_t> epoch_{0};
+    alignas(kCacheLineSize) std::atomic<std::size_t> unreclaimed_{0};
+};
+
+}  // namespace reclaim
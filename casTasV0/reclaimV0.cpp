@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "reclaim.h"
+#include "timedRun.h"
+
+// Read-mostly workload for the reclamation domains: readers keep loading a
+// shared `std::atomic<Config*>` and reading the object behind it while one
+// writer swaps in a new object and retires the old one.
+//   none    no protection, retired objects are only freed at the end
+//           (unsafe in general; the read-side floor)
+//   hazard  reclaim::HazardDomain
+//   epoch   reclaim::EpochDomain
+// Reported: reader M reads/s, ns per guarded read, writer swaps/s and the
+// peak number of retired-but-unfreed objects. With `stall`, one extra reader
+// enters a guard and sleeps for the whole run, which is where the two
+// schemes differ: hazard pointers pin one object, epochs pin all of them.
+
+using Clock = std::chrono::steady_clock;
+
+struct Config {
+    std::uint64_t version;
+    std::uint64_t check;  // version * 7, verified by readers
+};
+
+struct NoDomain {
+    struct Guard {
+        explicit Guard(NoDomain&) {}
+        template <typename T>
+        T* protect(int, const std::atomic<T*>& src) {
+            return src.load(std::memory_order_acquire);
+        }
+    };
+    template <typename T>
+    void retire(T* p) {
+        retired.push_back(p);
+    }
+    std::size_t unreclaimed() const { return retired.size(); }
+    ~NoDomain() {
+        for (auto* p : retired) delete static_cast<Config*>(p);
+    }
+    std::vector<void*> retired;
+};
+
+struct Result {
+    double reads_per_sec;
+    double swaps_per_sec;
+    std::size_t peak_unreclaimed;
+    bool ok;
+};
+
+template <typename Domain>
+Result run(int readers, std::chrono::milliseconds duration, bool stall) {
+    Domain domain;
+    std::atomic<Config*> current{new Config{0, 0}};
+
+    TimedRun bench;
+    bench.workers(readers, [&](int) {
+        return [&] {
+            typename Domain::Guard g(domain);
+            Config* c = g.protect(0, current);
+            return c->check == c->version * 7;
+        };
+    });
+    if (stall)
+        bench.background([&](const std::atomic<bool>& stop) {
+            typename Domain::Guard g(domain);
+            g.protect(0, current);
+            while (!stop.load(std::memory_order_relaxed)) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        });
+
+    long swaps = 0;
+    std::size_t peak = 0;
+    TimedRun::Result r = bench.finish(duration, [&](Clock::time_point deadline) {
+        while (Clock::now() < deadline) {
+            for (int i = 0; i < 64; ++i) {
+                ++swaps;
+                Config* old = current.exchange(new Config{static_cast<std::uint64_t>(swaps),
+                                                          static_cast<std::uint64_t>(swaps) * 7});
+                domain.retire(old);
+                peak = std::max(peak, domain.unreclaimed());
+            }
+            std::this_thread::yield();  // read-mostly: let the readers run
+        }
+    });
+    delete current.load();
+    return {r.ops_per_sec, swaps / r.seconds, peak, r.ok};
+}
+
+// ./reclaimV0 [max_readers] [ms_per_run]
+int main(int argc, char** argv) {
+    int max_readers = argc > 1 ? std::atoi(argv[1]) : 16;
+    std::chrono::milliseconds duration(argc > 2 ? std::atoi(argv[2]) : 300);
+
+    for (bool stall : {false, true}) {
+        std::cout << (stall ? "\nwith one stalled reader\n" : "");
+        std::cout << "readers\tdomain\tM reads/s\tns/read\tswaps/s\tpeak unreclaimed\n";
+        doubling(max_readers, [&](int readers) {
+            auto print = [&](const char* name, Result r) {
+                std::cout << readers << "\t" << name << "\t" << r.reads_per_sec / 1e6 << "\t"
+                          << readers * 1e9 / r.reads_per_sec << "\t" << r.swaps_per_sec << "\t"
+                          << r.peak_unreclaimed << (r.ok ? "" : "\tUSE AFTER FREE") << "\n";
+            };
+            print("none", run<NoDomain>(readers, duration, stall));
+            print("hazard", run<reclaim::HazardDomain>(readers, duration, stall));
+            print("epoch", run<reclaim::EpochDomain>(readers, duration, stall));
+        });
+    }
+    return 0;
+}
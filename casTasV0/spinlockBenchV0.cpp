@@ -0,0 +1,105 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "spinlocks.h"
+
+// Lock contention sweep: threads x critical-section length for
+//   mutex  std::mutex (futex-based, parks waiters)
+//   tas    TasLock, the tasV0.cpp loop
+//   ttas   TtasLock (test-and-test-and-set + exponential backoff)
+//   ticket TicketLock
+//   mcs    McsLock
+//   clh    ClhLock
+// Each thread acquires the lock in a loop for a fixed time; inside it bumps
+// `cs` words of shared, unsynchronised state, outside it does a short
+// private delay. Reported: M acquisitions/s and fairness (fewest / most
+// acquisitions by one thread; 1.0 is perfectly fair). The shared state is
+// checked against the acquisition count to catch broken mutual exclusion.
+//
+// With more threads than cores the FIFO locks hand the lock to waiters that
+// may not be running; that collapse is part of what the sweep shows.
+
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+    double ops_per_sec;
+    double fairness;
+    bool ok;
+};
+
+struct alignas(kCacheLineSize) PerThread {
+    long count = 0;
+};
+
+template <typename Lock>
+Result run(int threads, int cs, std::chrono::milliseconds duration) {
+    Lock lock;
+    std::vector<std::uint64_t> shared(std::max(cs, 1), 0);
+    std::atomic<bool> start{false}, stop{false};
+    std::vector<PerThread> counts(threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t)
+        workers.emplace_back([&, t] {
+            while (!start.load(std::memory_order_acquire)) std::this_thread::yield();
+            long n = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                {
+                    std::lock_guard<Lock> guard(lock);
+                    for (int i = 0; i < cs; ++i) ++shared[i];
+                    if (cs == 0) ++shared[0];
+                }
+                ++n;
+                for (int i = 0; i < 16; ++i) cpu_relax();  // non-critical work
+            }
+            counts[t].count = n;
+        });
+
+    auto begin = Clock::now();
+    start.store(true, std::memory_order_release);
+    std::this_thread::sleep_for(duration);
+    stop.store(true, std::memory_order_relaxed);
+    for (auto& w : workers) w.join();
+    std::chrono::duration<double> secs = Clock::now() - begin;
+
+    long total = 0, lo = counts[0].count, hi = counts[0].count;
+    for (auto& c : counts) {
+        total += c.count;
+        lo = std::min(lo, c.count);
+        hi = std::max(hi, c.count);
+    }
+    bool ok = true;
+    for (auto v : shared) ok &= v == static_cast<std::uint64_t>(total);
+    return {total / secs.count(), hi ? static_cast<double>(lo) / hi : 1.0, ok};
+}
+
+// ./spinlockBenchV0 [max_threads] [ms_per_run]
+int main(int argc, char** argv) {
+    int max_threads = argc > 1 ? std::atoi(argv[1]) : 64;
+    std::chrono::milliseconds duration(argc > 2 ? std::atoi(argv[2]) : 200);
+
+    std::cout << "M acquisitions/s (fairness min/max)\n";
+    std::cout << "threads\tcs\tmutex\ttas\tttas\tticket\tmcs\tclh\n";
+    for (int cs : {0, 10, 100}) {
+        for (int threads = 1;; threads = std::min(threads * 2, max_threads)) {
+            Result r[] = {run<std::mutex>(threads, cs, duration), run<TasLock>(threads, cs, duration),
+                          run<TtasLock>(threads, cs, duration),   run<TicketLock>(threads, cs, duration),
+                          run<McsLock>(threads, cs, duration),    run<ClhLock>(threads, cs, duration)};
+            std::cout << threads << "\t" << cs;
+            for (const Result& x : r) {
+                std::cout << "\t" << x.ops_per_sec / 1e6 << " (" << x.fairness << ")";
+                if (!x.ok) std::cout << " MUTUAL EXCLUSION BROKEN";
+            }
+            std::cout << "\n";
+            if (threads >= max_threads) break;
+        }
+    }
+    return 0;
+}
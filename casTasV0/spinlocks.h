@@ -0,0 +1,310 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+
+#include "../producerConsumerV0/cacheLine.h"
+#include "../producerConsumerV0/waitStrategy.h"
+
+// Spinlocks with one interface: lock() / try_lock() / unlock(), so all of
+// them work with std::lock_guard / std::unique_lock / std::scoped_lock.
+//
+//   TasLock     test_and_set in a loop, as in tasV0.cpp. Every waiter writes
+//               the lock's cache line on every iteration.
+//   TtasLock    spin on a plain load and only test_and_set when the lock
+//               looks free; exponential backoff after a failed attempt.
+//   TicketLock  FIFO: take a ticket, wait for `serving` to reach it. Waiters
+//               back off in proportion to their distance from the front.
+//   McsLock     FIFO queue lock: each waiter spins on its own node, so a
+//               release touches exactly one other core's cache line.
+//   ClhLock     FIFO queue lock: each waiter spins on its predecessor's node.
+//               try_lock() can, rarely, wait for a holder (see there).
+//
+// The queue locks need a node per acquisition. lock()/unlock() take one
+// from a small thread_local table (a thread may hold kMaxHeldQueueLocks
+// queue locks at once); McsLock also has lock(node)/unlock(node) for callers
+// that keep their own.
+//
+// All waiters spin with a pause hint and fall back to yielding (see
+// SpinWait), because spinning only helps while the holder is running on
+// another core.
+
+constexpr int kMaxHeldQueueLocks = 8;
+
+// Pause-hinted spinning that degrades to sched_yield after
+// default_spin_iterations() rounds (immediately on a single CPU).
+class SpinWait {
+public:
+    void pause() {
+        if (count_ < default_spin_iterations()) {
+            cpu_relax();
+            ++count_;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    int count_ = 0;
+};
+
+class TasLock {
+public:
+    void lock() {
+        while (flag_.test_and_set(std::memory_order_acquire)) {
+            // Busy wait (spin) until lock is free
+        }
+    }
+    bool try_lock() { return !flag_.test_and_set(std::memory_order_acquire); }
+    void unlock() { flag_.clear(std::memory_order_release); }
+
+private:
+    alignas(kCacheLineSize) std::atomic_flag flag_ = ATOMIC_FLAG_INIT;
+};
+
+class TtasLock {
+public:
+    void lock() {
+        int limit = kMinBackoff;
+        for (;;) {
+            // Read-only spin: the line stays shared in every waiter's cache
+            // until the holder's release invalidates it.
+            SpinWait wait;
+            while (locked_.load(std::memory_order_relaxed)) wait.pause();
+            if (!locked_.exchange(true, std::memory_order_acquire)) return;
+            // Lost the race: back off so the winners' traffic dies down.
+            backoff(limit);
+        }
+    }
+    bool try_lock() {
+        return !locked_.load(std::memory_order_relaxed) && !locked_.exchange(true, std::memory_order_acquire);
+    }
+    void unlock() { locked_.store(false, std::memory_order_release); }
+
+private:
+    static constexpr int kMinBackoff = 4;
+    static constexpr int kMaxBackoff = 1024;
+
+    static void backoff(int& limit) {
+        if (default_spin_iterations() == 0) {
+            std::this_thread::yield();
+            return;
+        }
+        for (int i = 0; i < limit; ++i) cpu_relax();
+        if (limit < kMaxBackoff) limit *= 2;
+    }
+
+    alignas(kCacheLineSize) std::atomic<bool> locked_{false};
+};
+
+class TicketLock {
+public:
+    void lock() {
+        const std::uint32_t ticket = next_.fetch_add(1, std::memory_order_relaxed);
+        SpinWait wait;
+        for (;;) {
+            const std::uint32_t serving = serving_.load(std::memory_order_acquire);
+            if (serving == ticket) return;
+            // Proportional backoff: the k-th in line will not get in for at
+            // least k critical sections, so it need not poll every cycle.
+            if (default_spin_iterations() == 0) {
+                std::this_thread::yield();
+                continue;
+            }
+            for (std::uint32_t i = 0, n = (ticket - serving) * kBackoffPerWaiter; i < n; ++i) cpu_relax();
+            wait.pause();
+        }
+    }
+    bool try_lock() {
+        std::uint32_t serving = serving_.load(std::memory_order_acquire);
+        std::uint32_t expected = serving;
+        return next_.compare_exchange_strong(expected, serving + 1, std::memory_order_acquire,
+                                             std::memory_order_relaxed);
+    }
+    void unlock() {
+        // Only the holder writes serving_, so a plain increment is enough.
+        serving_.store(serving_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+private:
+    static constexpr std::uint32_t kBackoffPerWaiter = 32;
+
+    alignas(kCacheLineSize) std::atomic<std::uint32_t> next_{0};
+    alignas(kCacheLineSize) std::atomic<std::uint32_t> serving_{0};
+};
+
+class McsLock {
+public:
+    struct Node {
+        alignas(kCacheLineSize) std::atomic<Node*> next{nullptr};
+        std::atomic<bool> locked{false};
+    };
+
+    void lock(Node& me) {
+        me.next.store(nullptr, std::memory_order_relaxed);
+        me.locked.store(true, std::memory_order_relaxed);
+        Node* prev = tail_.exchange(&me, std::memory_order_acq_rel);
+        if (!prev) return;  // queue was empty
+        prev->next.store(&me, std::memory_order_release);
+        SpinWait wait;
+        while (me.locked.load(std::memory_order_acquire)) wait.pause();
+    }
+
+    bool try_lock(Node& me) {
+        me.next.store(nullptr, std::memory_order_relaxed);
+        Node* expected = nullptr;
+        return tail_.compare_exchange_strong(expected, &me, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock(Node& me) {
+        Node* next = me.next.load(std::memory_order_acquire);
+        if (!next) {
+            Node* expected = &me;
+            if (tail_.compare_exchange_strong(expected, nullptr, std::memory_order_release,
+                                              std::memory_order_relaxed))
+                return;  // nobody waiting
+            // A successor swapped the tail but has not linked itself yet.
+            SpinWait wait;
+            while (!(next = me.next.load(std::memory_order_acquire))) wait.pause();
+        }
+        next->locked.store(false, std::memory_order_release);
+    }
+
+    void lock() { lock(held().acquire(this)); }
+    bool try_lock() {
+        Node& node = held().acquire(this);
+        if (try_lock(node)) return true;
+        held().release(this);
+        return false;
+    }
+    void unlock() {
+        Node& node = held().find(this);
+        unlock(node);
+        held().release(this);
+    }
+
+private:
+    // Nodes of the MCS locks this thread holds or is waiting for.
+    struct Held {
+        Node nodes[kMaxHeldQueueLocks];
+        const McsLock* owner[kMaxHeldQueueLocks] = {};
+
+        Node& acquire(const McsLock* lock) {
+            for (int i = 0; i < kMaxHeldQueueLocks; ++i)
+                if (!owner[i]) {
+                    owner[i] = lock;
+                    return nodes[i];
+                }
+            std::abort();  // more than kMaxHeldQueueLocks queue locks held at once
+        }
+        Node& find(const McsLock* lock) {
+            for (int i = 0; i < kMaxHeldQueueLocks; ++i)
+                if (owner[i] == lock) return nodes[i];
+            std::abort();  // unlock() without lock()
+        }
+        void release(const McsLock* lock) {
+            for (int i = 0; i < kMaxHeldQueueLocks; ++i)
+                if (owner[i] == lock) {
+                    owner[i] = nullptr;
+                    return;
+                }
+        }
+    };
+    static Held& held() {
+        thread_local Held h;
+        return h;
+    }
+
+    alignas(kCacheLineSize) std::atomic<Node*> tail_{nullptr};
+};
+
+class ClhLock {
+public:
+    ClhLock() : tail_(new Node) {}  // released dummy node
+    ~ClhLock() { delete tail_.load(std::memory_order_relaxed); }
+    ClhLock(const ClhLock&) = delete;
+    ClhLock& operator=(const ClhLock&) = delete;
+
+    void lock() {
+        Slot& s = held().acquire(this);
+        s.mine->locked.store(true, std::memory_order_relaxed);
+        s.pred = tail_.exchange(s.mine, std::memory_order_acq_rel);
+        SpinWait wait;
+        while (s.pred->locked.load(std::memory_order_acquire)) wait.pause();
+    }
+
+    bool try_lock() {
+        Slot& s = held().acquire(this);
+        Node* pred = tail_.load(std::memory_order_acquire);
+        if (!pred->locked.load(std::memory_order_acquire)) {
+            s.mine->locked.store(true, std::memory_order_relaxed);
+            if (tail_.compare_exchange_strong(pred, s.mine, std::memory_order_acq_rel,
+                                              std::memory_order_relaxed)) {
+                // pred may have been released, reused as another thread's
+                // node and locked again between the load and the CAS (ABA).
+                // We are queued now and cannot back out, so wait our turn:
+                // almost always pred is still free and this exits at once.
+                s.pred = pred;
+                SpinWait wait;
+                while (pred->locked.load(std::memory_order_acquire)) wait.pause();
+                return true;
+            }
+        }
+        held().release(this);
+        return false;
+    }
+
+    void unlock() {
+        Slot& s = held().find(this);
+        Node* mine = s.mine;
+        // The successor (if any) spins on our node; from here on it is
+        // theirs, and the predecessor's node, which nobody else can reach
+        // now, becomes ours for the next acquisition.
+        s.mine = s.pred;
+        mine->locked.store(false, std::memory_order_release);
+        held().release(this);
+    }
+
+private:
+    struct Node {
+        alignas(kCacheLineSize) std::atomic<bool> locked{false};
+    };
+
+    struct Slot {
+        const ClhLock* owner = nullptr;
+        Node* mine = nullptr;  // owned by this thread while owner == nullptr
+        Node* pred = nullptr;
+    };
+
+    // Per-thread slots; each keeps a spare node between acquisitions.
+    struct Held {
+        Slot slots[kMaxHeldQueueLocks];
+
+        ~Held() {
+            for (auto& s : slots) delete s.mine;
+        }
+        Slot& acquire(const ClhLock* lock) {
+            for (auto& s : slots)
+                if (!s.owner) {
+                    s.owner = lock;
+                    if (!s.mine) s.mine = new Node;
+                    return s;
+                }
+            std::abort();  // more than kMaxHeldQueueLocks queue locks held at once
+        }
+        Slot& find(const ClhLock* lock) {
+            for (auto& s : slots)
+                if (s.owner == lock) return s;
+            std::abort();  // unlock() without lock()
+        }
+        void release(const ClhLock* lock) { find(lock).owner = nullptr; }
+    };
+    static Held& held() {
+        thread_local Held h;
+        return h;
+    }
+
+    alignas(kCacheLineSize) std::atomic<Node*> tail_;
+};
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#include "../producerConsumerV0/cacheLine.h"
+
+// Counter for many writers and occasional readers.
+//
+// cas_increment in casV0.cpp (and the mutex in mutexSemaphoreV0/mutexV0.cpp)
+// funnel every increment from every core through one cache line. Here the
+// count is split over cache-line-padded cells; add() touches only the
+// caller's cell and read() sums them:
+//
+//   StripedCounter hits;                 // stripes: next pow2 >= #cpus
+//   hits.add();                          // hot path: one uncontended fetch_add
+//   std::int64_t n = hits.read();        // slow path: walks every cell
+//
+// Cells are picked per thread (threads are dealt cells round-robin on first
+// use) or per CPU (sched_getcpu on every add, which follows migrations but
+// costs a few ns). Two writers that share a cell are still correct, they
+// just contend. read() is the sum of per-cell snapshots taken one after
+// another, not a linearizable read: with concurrent adds (negative deltas
+// especially) the sum may be a value the counter never held. It is exact
+// once writers quiesce.
+class StripedCounter {
+public:
+    enum class Stripe { thread, cpu };
+
+    explicit StripedCounter(Stripe by = Stripe::thread, std::size_t stripes = 0)
+        : by_(by), mask_(round_up_pow2(stripes ? stripes : std::thread::hardware_concurrency()) - 1),
+          cells_(new Cell[mask_ + 1]) {}
+    StripedCounter(const StripedCounter&) = delete;
+    StripedCounter& operator=(const StripedCounter&) = delete;
+
+    void add(std::int64_t delta = 1) { cells_[index() & mask_].value.fetch_add(delta, std::memory_order_relaxed); }
+
+    std::int64_t read() const {
+        std::int64_t sum = 0;
+        for (std::size_t i = 0; i <= mask_; ++i) sum += cells_[i].value.load(std::memory_order_relaxed);
+        return sum;
+    }
+
+    std::size_t stripes() const { return mask_ + 1; }
+
+private:
+    struct alignas(kCacheLineSize) Cell {
+        std::atomic<std::int64_t> value{0};
+    };
+
+    static std::size_t round_up_pow2(std::size_t n) {
+        std::size_t p = 1;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    std::size_t index() const {
+#if defined(__linux__)
+        if (by_ == Stripe::cpu) {
+            const int cpu = sched_getcpu();
+            if (cpu >= 0) return static_cast<std::size_t>(cpu);
+        }
+#endif
+        return thread_slot();
+    }
+
+    static std::size_t thread_slot() {
+        static std::atomic<std::size_t> next{0};
+        thread_local const std::size_t slot = next.fetch_add(1, std::memory_order_relaxed);
+        return slot;
+    }
+
+    const Stripe by_;
+    const std::size_t mask_;
+    const std::unique_ptr<Cell[]> cells_;
+};
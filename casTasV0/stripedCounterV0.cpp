@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "stripedCounter.h"
+
+// Counting from many threads:
+//   cas       load + compare_exchange_weak loop (cas_increment in casV0.cpp)
+//   fetch_add one atomic increment on a single counter
+//   mutex     ++counter under std::mutex (mutexSemaphoreV0/mutexV0.cpp)
+//   striped/t StripedCounter, one cell per thread
+//   striped/c StripedCounter, one cell per CPU
+// Each thread adds `n` times; the final read() must equal threads * n.
+
+using Clock = std::chrono::steady_clock;
+
+template <typename Add, typename Read>
+double run(int threads, long n, Add add, Read read, bool& ok) {
+    std::vector<std::thread> workers;
+    auto start = Clock::now();
+    for (int t = 0; t < threads; ++t)
+        workers.emplace_back([&] {
+            for (long i = 0; i < n; ++i) add();
+        });
+    for (auto& w : workers) w.join();
+    std::chrono::duration<double> secs = Clock::now() - start;
+    ok &= read() == static_cast<std::int64_t>(threads) * n;
+    return threads * n / secs.count();
+}
+
+// ./stripedCounterV0 [max_threads] [adds_per_thread]
+int main(int argc, char** argv) {
+    int max_threads = argc > 1 ? std::atoi(argv[1]) : 64;
+    long n = argc > 2 ? std::atol(argv[2]) : 1000000;
+
+    std::cout << "threads\tcas\tfetch_add\tmutex\tstriped/t\tstriped/c   (M adds/s)\n";
+    for (int threads = 1;; threads = std::min(threads * 2, max_threads)) {
+        bool ok = true;
+
+        alignas(kCacheLineSize) std::atomic<std::int64_t> cas_counter{0};
+        double cas = run(threads, n,
+                         [&] {
+                             std::int64_t expected = cas_counter.load();
+                             while (!cas_counter.compare_exchange_weak(expected, expected + 1)) {
+                             }
+                         },
+                         [&] { return cas_counter.load(); }, ok);
+
+        alignas(kCacheLineSize) std::atomic<std::int64_t> counter{0};
+        double fa = run(threads, n, [&] { counter.fetch_add(1, std::memory_order_relaxed); },
+                        [&] { return counter.load(); }, ok);
+
+        std::mutex mtx;
+        std::int64_t locked_counter = 0;
+        double mu = run(threads, n,
+                        [&] {
+                            std::lock_guard<std::mutex> lock(mtx);
+                            ++locked_counter;
+                        },
+                        [&] { return locked_counter; }, ok);
+
+        StripedCounter by_thread(StripedCounter::Stripe::thread);
+        double st = run(threads, n, [&] { by_thread.add(); }, [&] { return by_thread.read(); }, ok);
+
+        StripedCounter by_cpu(StripedCounter::Stripe::cpu);
+        double sc = run(threads, n, [&] { by_cpu.add(); }, [&] { return by_cpu.read(); }, ok);
+
+        std::cout << threads << "\t" << cas / 1e6 << "\t" << fa / 1e6 << "\t" << mu / 1e6 << "\t" << st / 1e6
+                  << "\t" << sc / 1e6 << (ok ? "" : "\tWRONG TOTAL") << "\n";
+        if (threads >= max_threads) break;
+    }
+    return 0;
+}
@@ -2,17 +2,23 @@
 #include <iostream>
 #include <thread>
 
+#include "../asyncLoggerV0/asyncLogger.h"
+#include "contention.h"
+
 std::atomic_flag tas_lock = ATOMIC_FLAG_INIT;
 
 void tas_critical_section(int id) {
+    CONTENTION_PROBE(probe, "tas_critical_section", Spins);
     while (tas_lock.test_and_set(std::memory_order_acquire)) {
         // Busy wait (spin) until lock is free
+        CONTENTION_SPIN(probe);
     }
+    CONTENTION_ACQUIRED(probe);
 
-    // Critical section
-    std::cout << "[TAS] Thread " << id << " entered critical section.\n";
+    // Critical section (logging is async so the lock is not held across terminal I/O)
+    alog::log("[TAS] Thread {} entered critical section.\n", id);
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    std::cout << "[TAS] Thread " << id << " leaving critical section.\n";
+    alog::log("[TAS] Thread {} leaving critical section.\n", id);
 
     tas_lock.clear(std::memory_order_release);
 }
@@ -23,6 +29,8 @@ int main() {
 
     t1.join();
     t2.join();
+    alog::flush();
+    CONTENTION_REPORT(std::cout);  // only with -DCONTENTION_STATS
     return 0;
 }
 
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <set>
+#include <string>
+
+// Per-thread log2 histograms keyed by named site, merged on demand.
+// Shared by contention.h (CAS / TAS retry statistics) and
+// mutexTypes/lockProfiler.h (lock wait / hold times).
+//
+//   struct MyStats {                       // one per site per thread
+//       threadhist::Histogram wait;
+//       void merge(const MyStats& o) { wait.merge(o.wait); }
+//   };
+//   using Sites = threadhist::SiteRegistry<MyStats, 16>;
+//   static const int s = Sites::instance().site("name");
+//   Sites::instance().local(s).wait.record(v);          // hot path
+//   Sites::instance().for_each_site([](const std::string& name, const MyStats& total) { ... });
+//
+// Threads only write their own buffers (no shared cache line on the hot
+// path). A buffer registers itself on the thread's first local() and folds
+// into an "exited" total when the thread ends, so for_each_site() sees live
+// and finished threads alike. Kept C++11 so casV0.cpp can use it.
+namespace threadhist {
+
+const int kBuckets = 48;  // bucket b counts values in [2^(b-1), 2^b); bucket 0 counts zeros
+
+// Written by one thread, read by the reporter: relaxed load + store, no RMW.
+struct Histogram {
+    std::atomic<std::uint64_t> buckets[kBuckets];
+    std::atomic<std::uint64_t> count, sum, max;
+
+    Histogram() { clear(); }
+
+    void clear() {
+        for (auto& b : buckets) b.store(0, std::memory_order_relaxed);
+        count.store(0, std::memory_order_relaxed);
+        sum.store(0, std::memory_order_relaxed);
+        max.store(0, std::memory_order_relaxed);
+    }
+
+    static void bump(std::atomic<std::uint64_t>& a, std::uint64_t d) {
+        a.store(a.load(std::memory_order_relaxed) + d, std::memory_order_relaxed);
+    }
+
+    // Bucket of v: its bit width, capped at the last bucket.
+    static int bucket(std::uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+        const int b = v == 0 ? 0 : 64 - __builtin_clzll(v);
+#else
+        int b = 0;
+        while (b < 64 && (v >> b) != 0) ++b;
+#endif
+        return b < kBuckets - 1 ? b : kBuckets - 1;
+    }
+
+    void record(std::uint64_t v) {
+        bump(buckets[bucket(v)], 1);
+        bump(count, 1);
+        bump(sum, v);
+        if (v > max.load(std::memory_order_relaxed)) max.store(v, std::memory_order_relaxed);
+    }
+
+    // Not thread-safe on `this`; the caller holds the registry lock.
+    void merge(const Histogram& o) {
+        for (int b = 0; b < kBuckets; ++b) bump(buckets[b], o.buckets[b].load(std::memory_order_relaxed));
+        bump(count, o.count.load(std::memory_order_relaxed));
+        bump(sum, o.sum.load(std::memory_order_relaxed));
+        if (o.max.load(std::memory_order_relaxed) > max.load(std::memory_order_relaxed))
+            max.store(o.max.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    // Upper bound of the bucket holding the p-quantile, clamped to the
+    // largest value actually recorded.
+    std::uint64_t quantile(double p) const {
+        const std::uint64_t n = count.load(std::memory_order_relaxed);
+        const std::uint64_t top = max.load(std::memory_order_relaxed);
+        std::uint64_t seen = 0;
+        for (int b = 0; b < kBuckets; ++b) {
+            seen += buckets[b].load(std::memory_order_relaxed);
+            if (seen > p * n) {
+                const std::uint64_t bound = b == 0 ? 0 : (std::uint64_t(1) << b) - 1;
+                return bound < top ? bound : top;
+            }
+        }
+        return top;
+    }
+
+    double mean() const {
+        const std::uint64_t n = count.load(std::memory_order_relaxed);
+        return n ? static_cast<double>(sum.load(std::memory_order_relaxed)) / n : 0.0;
+    }
+};
+
+// Site names plus every thread's Stats[MaxSites]. Stats must be default
+// constructible and have merge(const Stats&).
+template <typename Stats, int MaxSites>
+class SiteRegistry {
+public:
+    static SiteRegistry& instance() {
+        static SiteRegistry* r = new SiteRegistry;  // never destroyed: threads may exit after main
+        return *r;
+    }
+
+    // Returns the id for `name`, registering it on first use.
+    int site(const std::string& name) {
+        std::lock_guard<std::mutex> lock(mtx_);
+        for (int s = 0; s < sites_; ++s)
+            if (names_[s] == name) return s;
+        if (sites_ == MaxSites) std::abort();  // raise MaxSites
+        names_[sites_] = name;
+        return sites_++;
+    }
+
+    // The calling thread's stats for `site`.
+    Stats& local(int site) {
+        thread_local Buffer buffer(*this);
+        return buffer.sites[site];
+    }
+
+    // Calls f(name, total) per registered site, totals merged over live and
+    // exited threads. Holds the registry lock throughout.
+    template <typename F>
+    void for_each_site(F f) {
+        std::lock_guard<std::mutex> lock(mtx_);
+        for (int s = 0; s < sites_; ++s) {
+            Stats total;
+            total.merge(exited_[s]);
+            for (Buffer* b : live_) total.merge(b->sites[s]);
+            f(names_[s], total);
+        }
+    }
+
+private:
+    struct Buffer {
+        SiteRegistry& owner;
+        Stats sites[MaxSites];
+
+        explicit Buffer(SiteRegistry& r) : owner(r) {
+            std::lock_guard<std::mutex> lock(owner.mtx_);
+            owner.live_.insert(this);
+        }
+        ~Buffer() {
+            std::lock_guard<std::mutex> lock(owner.mtx_);
+            for (int s = 0; s < MaxSites; ++s) owner.exited_[s].merge(sites[s]);
+            owner.live_.erase(this);
+        }
+    };
+
+    SiteRegistry() : sites_(0) {}
+
+    std::mutex mtx_;
+    std::string names_[MaxSites];
+    int sites_;
+    std::set<Buffer*> live_;
+    Stats exited_[MaxSites];  // threads that have finished
+};
+
+}  // namespace threadhist
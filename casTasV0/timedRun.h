@@ -0,0 +1,101 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Harness for the timed read-mostly benchmarks (reclaimV0,
+// mutexTypes/seqlockV0, mutexTypes/bravoRwLockV0): N worker threads repeat
+// one operation for a fixed time and check what they read; background
+// threads (a writer, a stalled reader) run alongside; the calling thread
+// either sleeps or does its own work until the deadline.
+//
+//   TimedRun run;
+//   run.workers(readers, [&](int t) {            // called once per worker
+//       return [&] { return read().consistent(); };   // false: torn read
+//   });
+//   run.background([&](const std::atomic<bool>& stop) { while (!stop) write(); });
+//   TimedRun::Result r = run.finish(std::chrono::milliseconds(200));
+//   // r.ops_per_sec over all workers, r.ok false if any check failed
+//
+// Workers count and check locally and publish once when they stop, so the
+// harness adds no shared writes to the measured loop and no data race on
+// the result.
+class TimedRun {
+public:
+    struct Result {
+        double ops_per_sec;
+        double seconds;
+        bool ok;
+    };
+
+    TimedRun() = default;
+    TimedRun(const TimedRun&) = delete;
+    TimedRun& operator=(const TimedRun&) = delete;
+    ~TimedRun() { stop_and_join(); }
+
+    // Starts n workers. make_op(t) runs on worker t and returns the
+    // operation, a callable returning false when the check failed.
+    template <typename MakeOp>
+    void workers(int n, MakeOp make_op) {
+        for (int t = 0; t < n; ++t)
+            threads_.emplace_back([this, t, make_op] {
+                auto op = make_op(t);
+                long n = 0;
+                bool good = true;
+                while (!stop_.load(std::memory_order_relaxed)) {
+                    good &= op();
+                    ++n;
+                }
+                ops_.fetch_add(n, std::memory_order_relaxed);
+                if (!good) bad_.store(true, std::memory_order_relaxed);
+            });
+    }
+
+    // Starts a thread running f(stop) once; f returns when stop is set.
+    template <typename F>
+    void background(F f) {
+        threads_.emplace_back([this, f] { f(stop_); });
+    }
+
+    // Runs foreground(deadline) on the calling thread (it should return at
+    // the deadline), then stops and joins every thread.
+    template <typename F>
+    Result finish(std::chrono::steady_clock::duration duration, F foreground) {
+        const auto start = std::chrono::steady_clock::now();
+        foreground(start + duration);
+        stop_and_join();
+        const std::chrono::duration<double> secs = std::chrono::steady_clock::now() - start;
+        return {ops_.load() / secs.count(), secs.count(), !bad_.load()};
+    }
+
+    Result finish(std::chrono::steady_clock::duration duration) {
+        return finish(duration, [](std::chrono::steady_clock::time_point deadline) {
+            std::this_thread::sleep_until(deadline);
+        });
+    }
+
+private:
+    void stop_and_join() {
+        stop_ = true;
+        for (auto& t : threads_) t.join();
+        threads_.clear();
+    }
+
+    std::atomic<bool> stop_{false};
+    std::atomic<long> ops_{0};
+    std::atomic<bool> bad_{false};
+    std::vector<std::thread> threads_;
+};
+
+// Calls f(n) for n = 1, 2, 4, ... and always max itself.
+template <typename F>
+void doubling(int max, F f) {
+    for (int n = 1;; n = std::min(n * 2, max)) {
+        f(n);
+        if (n >= max) break;
+    }
+}
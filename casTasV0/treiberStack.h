@@ -0,0 +1,120 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include "../producerConsumerV0/cacheLine.h"
+
+// Bounded lock-free LIFO (Treiber stack) for recycling buffers between
+// threads, built on the same compare_exchange_weak loop as casV0.cpp.
+//
+//   TreiberStack<Buffer*> spare(1024);
+//   spare.push(buf);               // false if all 1024 nodes are in use
+//   Buffer* b; if (spare.pop(b)) ...
+//
+// ABA: a plain pointer CAS can succeed after the top node was popped and
+// pushed back in between, installing a stale `next`. Here nodes live in one
+// preallocated array and the head is a 64-bit word holding {32-bit node
+// index, 32-bit tag}; every successful CAS bumps the tag, so a head that
+// went A -> B -> A no longer compares equal. Nodes are never returned to the
+// allocator while the stack exists, which makes reading `next` of a node
+// another thread just popped harmless (it is re-validated by the CAS).
+//
+// Free nodes sit on a second tagged stack over the same array, so push and
+// pop never allocate.
+template <typename T>
+class TreiberStack {
+public:
+    // Throws std::invalid_argument if capacity >= kNil: node indices are 32
+    // bits and kNil marks the end of a list.
+    explicit TreiberStack(std::size_t capacity) : nodes_(new Node[checked_capacity(capacity)]) {
+        for (std::size_t i = 0; i < capacity; ++i)
+            nodes_[i].next.store(i + 1 < capacity ? static_cast<std::uint32_t>(i + 1) : kNil,
+                                 std::memory_order_relaxed);
+        free_.store(pack(capacity ? 0 : kNil, 0), std::memory_order_relaxed);
+    }
+    ~TreiberStack() {
+        for (std::uint32_t i = index_of(head_.load(std::memory_order_relaxed)); i != kNil;
+             i = nodes_[i].next.load(std::memory_order_relaxed))
+            nodes_[i].value()->~T();
+    }
+    TreiberStack(const TreiberStack&) = delete;
+    TreiberStack& operator=(const TreiberStack&) = delete;
+
+    // Returns false if every node is in use.
+    bool push(T value) {
+        const std::uint32_t i = take(free_);
+        if (i == kNil) return false;
+        ::new (static_cast<void*>(nodes_[i].storage)) T(std::move(value));
+        give(head_, i);
+        return true;
+    }
+
+    // Returns false if the stack is empty.
+    bool pop(T& out) {
+        const std::uint32_t i = take(head_);
+        if (i == kNil) return false;
+        out = std::move(*nodes_[i].value());
+        nodes_[i].value()->~T();
+        give(free_, i);
+        return true;
+    }
+
+    // Approximate when called concurrently.
+    bool empty() const { return index_of(head_.load(std::memory_order_acquire)) == kNil; }
+
+private:
+    static constexpr std::uint32_t kNil = 0xffffffffu;
+
+    static std::size_t checked_capacity(std::size_t capacity) {
+        if (capacity >= kNil) throw std::invalid_argument("TreiberStack capacity must be below 2^32-1");
+        return capacity;
+    }
+
+    struct Node {
+        // Atomic because a losing popper may read it while the winner
+        // re-links the node.
+        std::atomic<std::uint32_t> next{kNil};
+        alignas(T) unsigned char storage[sizeof(T)];
+        T* value() { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    static std::uint64_t pack(std::uint32_t index, std::uint32_t tag) {
+        return static_cast<std::uint64_t>(tag) << 32 | index;
+    }
+    static std::uint32_t index_of(std::uint64_t head) { return static_cast<std::uint32_t>(head); }
+    static std::uint32_t tag_of(std::uint64_t head) { return static_cast<std::uint32_t>(head >> 32); }
+
+    // Pops a node index off `stack`, kNil if empty.
+    std::uint32_t take(std::atomic<std::uint64_t>& stack) {
+        std::uint64_t head = stack.load(std::memory_order_acquire);
+        for (;;) {
+            const std::uint32_t i = index_of(head);
+            if (i == kNil) return kNil;
+            const std::uint32_t next = nodes_[i].next.load(std::memory_order_relaxed);
+            if (stack.compare_exchange_weak(head, pack(next, tag_of(head) + 1), std::memory_order_acquire,
+                                            std::memory_order_acquire))
+                return i;
+        }
+    }
+
+    // Pushes node `i` onto `stack`.
+    void give(std::atomic<std::uint64_t>& stack, std::uint32_t i) {
+        std::uint64_t head = stack.load(std::memory_order_relaxed);
+        for (;;) {
+            nodes_[i].next.store(index_of(head), std::memory_order_relaxed);
+            if (stack.compare_exchange_weak(head, pack(i, tag_of(head) + 1), std::memory_order_release,
+                                            std::memory_order_relaxed))
+                return;
+        }
+    }
+
+    const std::unique_ptr<Node[]> nodes_;
+    alignas(kCacheLineSize) std::atomic<std::uint64_t> head_{pack(kNil, 0)};
+    alignas(kCacheLineSize) std::atomic<std::uint64_t> free_;
+};
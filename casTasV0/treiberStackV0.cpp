@@ -0,0 +1,88 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "treiberStack.h"
+
+// Buffer recycling under contention: each thread repeatedly pushes a value
+// and pops one (a free list's take/give pattern), comparing
+//   treiber  TreiberStack (lock-free, tagged index head)
+//   mutex    std::vector guarded by std::mutex
+// The stack starts with `prefill` items so pops rarely see it empty. The sum
+// of everything popped plus what is left must equal everything pushed.
+
+using Clock = std::chrono::steady_clock;
+
+struct MutexStack {
+    explicit MutexStack(std::size_t capacity) { items.reserve(capacity); }
+    bool push(std::uint64_t v) {
+        std::lock_guard<std::mutex> lock(mtx);
+        items.push_back(v);
+        return true;
+    }
+    bool pop(std::uint64_t& out) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (items.empty()) return false;
+        out = items.back();
+        items.pop_back();
+        return true;
+    }
+    std::mutex mtx;
+    std::vector<std::uint64_t> items;
+};
+
+template <typename Stack>
+double run(int threads, long ops, std::size_t prefill, bool& ok) {
+    Stack stack(prefill + threads);
+    std::uint64_t pushed = 0;
+    for (std::size_t i = 1; i <= prefill; ++i) {
+        stack.push(i);
+        pushed += i;
+    }
+    std::atomic<std::uint64_t> pushed_total{pushed}, popped_total{0};
+
+    std::vector<std::thread> workers;
+    auto start = Clock::now();
+    for (int t = 0; t < threads; ++t)
+        workers.emplace_back([&, t] {
+            std::uint64_t in = 0, out = 0;
+            for (long i = 0; i < ops; ++i) {
+                const std::uint64_t v = static_cast<std::uint64_t>(t) * ops + i + prefill + 1;
+                if (stack.push(v)) in += v;
+                std::uint64_t got;
+                if (stack.pop(got)) out += got;
+            }
+            pushed_total += in;
+            popped_total += out;
+        });
+    for (auto& w : workers) w.join();
+    std::chrono::duration<double> secs = Clock::now() - start;
+
+    std::uint64_t got, rest = 0;
+    while (stack.pop(got)) rest += got;
+    ok &= popped_total + rest == pushed_total;
+    return 2.0 * threads * ops / secs.count();
+}
+
+// ./treiberStackV0 [max_threads] [ops_per_thread] [prefill]
+int main(int argc, char** argv) {
+    int max_threads = argc > 1 ? std::atoi(argv[1]) : 64;
+    long ops = argc > 2 ? std::atol(argv[2]) : 500000;
+    std::size_t prefill = argc > 3 ? std::atol(argv[3]) : 1024;
+
+    std::cout << "threads\ttreiber\tmutex   (M push+pop ops/s)\n";
+    for (int threads = 1;; threads = std::min(threads * 2, max_threads)) {
+        bool ok = true;
+        double t = run<TreiberStack<std::uint64_t>>(threads, ops, prefill, ok);
+        double m = run<MutexStack>(threads, ops, prefill, ok);
+        std::cout << threads << "\t" << t / 1e6 << "\t" << m / 1e6 << (ok ? "" : "\tCHECKSUM MISMATCH") << "\n";
+        if (threads >= max_threads) break;
+    }
+    return 0;
+}
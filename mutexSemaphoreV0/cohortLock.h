@@ -0,0 +1,171 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#include "../casTasV0/spinlocks.h"
+#include "../producerConsumerV0/cpuTopology.h"
+
+// NUMA-aware cohort lock (Dice, Marathe, Shavit, "Lock Cohorting").
+//
+// With `std::mutex mtx` in mutexV0.cpp or tas_lock in tasV0.cpp the next
+// owner is whichever core wins, so on a multi-socket box the lock word and
+// the data it protects bounce between sockets on most handoffs. Here every
+// NUMA node has its own local lock and the nodes compete for one global
+// lock:
+//
+//   lock():   take my node's local lock; if my node does not already own
+//             the global lock, take it too
+//   unlock(): if another thread on my node is queued and this node has
+//             passed the lock fewer than max_local_passes times in a row,
+//             hand over the local lock only (the global lock stays with the
+//             node); otherwise release global, then local
+//
+// so a burst of critical sections runs on one socket while its caches are
+// warm, and max_local_passes bounds how long the other nodes wait.
+//
+// Both levels are ticket locks: FIFO inside a node, FIFO between nodes, and
+// the global one may be released by a different thread than the one that
+// took it, which cohorting requires. Waiters spin with SpinWait, so they
+// yield when the holder is not running.
+//
+// The node layout comes from /sys/devices/system/node via CpuTopology; the
+// calling thread's node is looked up from sched_getcpu() on every lock().
+// On a single-node machine (or without sysfs) the global lock is skipped
+// and this is one ticket lock.
+//
+//   CohortLock lock;                         // detected nodes, 64 passes
+//   std::lock_guard<CohortLock> g(lock);
+//
+// set_thread_node() overrides the lookup for the calling thread, so the
+// handoff policy can be exercised on a single-node box with CohortLock(n).
+class CohortLock {
+public:
+    static constexpr unsigned kDefaultMaxLocalPasses = 64;
+
+    // nodes == 0: as many cohorts as detected NUMA nodes.
+    explicit CohortLock(int nodes = 0, unsigned max_local_passes = kDefaultMaxLocalPasses)
+        : nodes_(nodes > 0 ? nodes : detected_nodes()),
+          max_local_passes_(max_local_passes),
+          local_(new Local[nodes_]) {}
+    CohortLock(const CohortLock&) = delete;
+    CohortLock& operator=(const CohortLock&) = delete;
+
+    void lock() {
+        const int node = nodes_ == 1 ? 0 : current_node() % nodes_;
+        Local& l = local_[node];
+        const std::uint32_t ticket = l.next.fetch_add(1, std::memory_order_relaxed);
+        SpinWait wait;
+        while (l.serving.load(std::memory_order_acquire) != ticket) wait.pause();
+        if (nodes_ > 1 && !l.owns_global) {
+            global_.lock();
+            l.owns_global = true;
+            l.passes = 0;
+        }
+        holder_node_ = node;
+    }
+
+    bool try_lock() {
+        const int node = nodes_ == 1 ? 0 : current_node() % nodes_;
+        Local& l = local_[node];
+        std::uint32_t serving = l.serving.load(std::memory_order_acquire);
+        std::uint32_t expected = serving;
+        if (!l.next.compare_exchange_strong(expected, serving + 1, std::memory_order_acquire,
+                                            std::memory_order_relaxed))
+            return false;
+        if (nodes_ > 1 && !l.owns_global) {
+            if (!global_.try_lock()) {
+                l.serving.store(serving + 1, std::memory_order_release);
+                return false;
+            }
+            l.owns_global = true;
+            l.passes = 0;
+        }
+        holder_node_ = node;
+        return true;
+    }
+
+    void unlock() {
+        Local& l = local_[holder_node_];
+        const std::uint32_t serving = l.serving.load(std::memory_order_relaxed);
+        if (nodes_ > 1) {
+            const bool queued = l.next.load(std::memory_order_relaxed) != serving + 1;
+            if (!queued || ++l.passes >= max_local_passes_) {
+                l.owns_global = false;
+                global_.unlock();
+            }
+            // else: the next local owner inherits the global lock.
+        }
+        l.serving.store(serving + 1, std::memory_order_release);
+    }
+
+    int nodes() const { return nodes_; }
+
+    // Overrides the calling thread's node for every CohortLock; -1 goes back
+    // to sched_getcpu().
+    static void set_thread_node(int node) { thread_node() = node; }
+
+    // NUMA node of the CPU the caller is running on (0 if unknown).
+    static int current_node() {
+        const int forced = thread_node();
+        if (forced >= 0) return forced;
+#if defined(__linux__)
+        const int cpu = sched_getcpu();
+        const std::vector<int>& map = node_of_cpu();
+        if (cpu >= 0 && cpu < static_cast<int>(map.size())) return map[cpu];
+#endif
+        return 0;
+    }
+
+private:
+    struct alignas(kCacheLineSize) Local {
+        std::atomic<std::uint32_t> next{0};
+        std::atomic<std::uint32_t> serving{0};
+        // Written only by this node's local holder.
+        bool owns_global = false;
+        unsigned passes = 0;
+    };
+
+    static int& thread_node() {
+        thread_local int node = -1;
+        return node;
+    }
+
+    // CPU id -> dense node index (sysfs node ids may have gaps).
+    static const std::vector<int>& node_of_cpu() {
+        static const std::vector<int> map = [] {
+            const CpuTopology topo = CpuTopology::detect();
+            std::vector<int> m;
+            std::vector<int> ids;
+            for (const CpuInfo& c : topo.cpus()) {
+                int index = 0;
+                while (index < static_cast<int>(ids.size()) && ids[index] != c.node) ++index;
+                if (index == static_cast<int>(ids.size())) ids.push_back(c.node);
+                if (c.cpu >= static_cast<int>(m.size())) m.resize(c.cpu + 1, 0);
+                m[c.cpu] = index;
+            }
+            return m;
+        }();
+        return map;
+    }
+
+    static int detected_nodes() {
+        int n = 1;
+        for (int node : node_of_cpu()) n = std::max(n, node + 1);
+        return n;
+    }
+
+    const int nodes_;
+    const unsigned max_local_passes_;
+    std::unique_ptr<Local[]> local_;
+    TicketLock global_;
+    int holder_node_ = 0;  // only touched by the holder
+};
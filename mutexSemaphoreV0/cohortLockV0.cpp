@@ -0,0 +1,109 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cohortLock.h"
+
+// Throughput under cross-node contention: mutexV0.cpp's increment() with
+// more shared state. T threads, placed round-robin over sockets (spread),
+// each run `ops` critical sections that bump the counter and write
+// kLines cache lines of shared data, then do a little private work.
+//
+// Columns per lock: M critical sections/s, and the fraction of handoffs
+// where the previous holder was on another node (what cohorting reduces).
+// On a single-node machine pass virtual_nodes > 1: thread t then claims
+// node t % virtual_nodes, the cohort lock is built with that many cohorts,
+// and "node" in the handoff column means the virtual one. The data still
+// does not cross a socket there, so only the handoff column is meaningful.
+// With more threads than CPUs every FIFO lock here (ticket, cohort) stalls
+// whenever the next thread in line is preempted; compare at threads <= CPUs.
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int kLines = 8;
+
+struct Shared {
+    alignas(kCacheLineSize) std::uint64_t data[kLines][kCacheLineSize / sizeof(std::uint64_t)] = {};
+    long counter = 0;
+    int last_node = -1;
+    long remote_handoffs = 0;
+};
+
+struct Result {
+    double mops;
+    double remote_fraction;
+    bool ok;
+};
+
+template <typename Lock>
+Result run(Lock& lock, const std::vector<int>& cpus, int virtual_nodes, long ops) {
+    Shared s;
+    const int threads = static_cast<int>(cpus.size());
+    std::vector<std::thread> workers;
+    auto start = Clock::now();
+    for (int t = 0; t < threads; ++t)
+        workers.emplace_back([&, t] {
+            pin_this_thread(cpus[t]);
+            if (virtual_nodes > 1) CohortLock::set_thread_node(t % virtual_nodes);
+            const int node = CohortLock::current_node();
+            std::uint64_t local = t;
+            for (long i = 0; i < ops; ++i) {
+                {
+                    std::lock_guard<Lock> g(lock);
+                    ++s.counter;
+                    for (int l = 0; l < kLines; ++l) s.data[l][0] += i;
+                    if (s.last_node != node) {
+                        if (s.last_node >= 0) ++s.remote_handoffs;
+                        s.last_node = node;
+                    }
+                }
+                for (int k = 0; k < 32; ++k) local = local * 6364136223846793005ULL + 1;
+            }
+            if (local == 42) std::abort();  // keep the private work
+        });
+    for (auto& w : workers) w.join();
+    std::chrono::duration<double> secs = Clock::now() - start;
+    const long total = threads * ops;
+    std::uint64_t expect = static_cast<std::uint64_t>(threads) * (ops * (ops - 1) / 2);
+    bool ok = s.counter == total;
+    for (int l = 0; l < kLines; ++l) ok &= s.data[l][0] == expect;
+    return {total / secs.count() / 1e6, static_cast<double>(s.remote_handoffs) / total, ok};
+}
+
+template <typename Lock>
+void row(const char* name, Lock& lock, const std::vector<int>& cpus, int virtual_nodes, long ops) {
+    Result r = run(lock, cpus, virtual_nodes, ops);
+    std::cout << name << "\t" << r.mops << "\t" << r.remote_fraction << (r.ok ? "" : "\tCHECKSUM MISMATCH") << "\n";
+}
+
+// ./cohortLockV0 [threads] [ops_per_thread] [virtual_nodes]
+int main(int argc, char** argv) {
+    const CpuTopology topo = CpuTopology::detect();
+    int threads = argc > 1 ? std::atoi(argv[1]) : static_cast<int>(std::max<std::size_t>(2, topo.cpus().size()));
+    long ops = argc > 2 ? std::atol(argv[2]) : 200000;
+    int virtual_nodes = argc > 3 ? std::atoi(argv[3]) : 0;
+
+    const std::vector<int> cpus = plan_placement(topo, Placement::spread, threads, 0);
+    std::cout << topo.summary() << "; " << threads << " threads spread";
+    if (virtual_nodes > 1) std::cout << ", " << virtual_nodes << " virtual nodes";
+    std::cout << "\nlock\tM ops/s\tremote handoffs\n";
+
+    std::mutex mtx;
+    row("std::mutex", mtx, cpus, virtual_nodes, ops);
+    TasLock tas;
+    row("tas_lock", tas, cpus, virtual_nodes, ops);
+    TicketLock ticket;
+    row("ticket", ticket, cpus, virtual_nodes, ops);
+    for (unsigned passes : {1u, 16u, 64u, 256u}) {
+        CohortLock cohort(virtual_nodes > 1 ? virtual_nodes : 0, passes);
+        row(("cohort/" + std::to_string(cohort.nodes()) + " nodes/" + std::to_string(passes) + " passes").c_str(),
+            cohort, cpus, virtual_nodes, ops);
+    }
+    return 0;
+}
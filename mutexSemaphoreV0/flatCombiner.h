@@ -0,0 +1,158 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "../casTasV0/spinlocks.h"
+
+// Flat combining (Hendler, Incze, Shavit, Tzafrir, SPAA 2010).
+//
+// increment() in mutexV0.cpp takes the mutex once per `++counter`: every
+// thread pulls the lock word and the counter into its own cache in turn, so
+// each tiny update pays for two cache-line transfers. Here a thread instead
+// publishes its operation in a slot and whichever thread gets the combiner
+// lock runs every pending operation, its own included, in one pass:
+//
+//   FlatCombiner<std::map<int, long>> m;
+//   m.apply([](std::map<int, long>& s) { ++s[7]; });
+//   long v = m.apply([](std::map<int, long>& s) { return s[7]; });
+//
+//   apply(f):  claim a slot, store (f, &result), mark it pending
+//              loop: done?                -> return the result
+//                    combiner lock free?  -> take it, run all pending
+//                                            slots, release it
+//                    otherwise            -> spin / yield
+//
+// The protected state and the lock stay in the combiner's cache for a whole
+// batch, and a waiter only reads its own slot's line until the combiner
+// writes it once. apply() returns whatever f returns; f runs on some thread
+// (maybe not the caller's) while no other f runs, and must not call apply()
+// on the same combiner or throw.
+//
+// Slots live in a fixed array of Slots entries. Each thread starts its claim
+// at its own home index, so in practice every thread has a private slot;
+// with more concurrent callers than slots they just take the next free one.
+// Waiters spin with SpinWait, so they yield when the combiner is not running.
+template <typename T, int Slots = 64>
+class FlatCombiner {
+public:
+    template <typename... Args>
+    explicit FlatCombiner(Args&&... args) : state_(std::forward<Args>(args)...) {}
+    FlatCombiner(const FlatCombiner&) = delete;
+    FlatCombiner& operator=(const FlatCombiner&) = delete;
+
+    template <typename F>
+    auto apply(F f) -> decltype(f(std::declval<T&>())) {
+        using R = decltype(f(std::declval<T&>()));
+        Call<F, R> call{&f, {}};
+        Slot& s = claim();
+        s.run = &Call<F, R>::run;
+        s.call = &call;
+        s.state.store(kPending, std::memory_order_release);
+
+        SpinWait wait;
+        while (s.state.load(std::memory_order_acquire) != kDone) {
+            if (!locked_.load(std::memory_order_relaxed) && !locked_.exchange(true, std::memory_order_acquire)) {
+                combine();  // our own slot is pending, so this finishes it
+                locked_.store(false, std::memory_order_release);
+            } else {
+                wait.pause();
+            }
+        }
+        s.state.store(kFree, std::memory_order_release);
+        if constexpr (!std::is_void<R>::value) return std::move(*call.result);
+    }
+
+    // Operations per combining pass so far (1.0: no batching happened).
+    double average_batch() const {
+        const std::uint64_t passes = passes_.load(std::memory_order_relaxed);
+        return passes ? static_cast<double>(applied_.load(std::memory_order_relaxed)) / passes : 0.0;
+    }
+
+    // Direct access; only while no apply() can run.
+    T& unsafe_state() { return state_; }
+
+private:
+    enum : std::uint32_t { kFree, kClaimed, kPending, kDone };
+
+    struct alignas(kCacheLineSize) Slot {
+        std::atomic<std::uint32_t> state{kFree};
+        void (*run)(T&, void*) = nullptr;
+        void* call = nullptr;
+    };
+
+    template <typename F, typename R>
+    struct Call {
+        F* f;
+        std::optional<R> result;
+        static void run(T& state, void* p) {
+            Call* c = static_cast<Call*>(p);
+            c->result.emplace((*c->f)(state));
+        }
+    };
+    template <typename F>
+    struct Call<F, void> {
+        F* f;
+        int unused;
+        static void run(T& state, void* p) { (*static_cast<Call*>(p)->f)(state); }
+    };
+
+    static int home() {
+        static std::atomic<int> next{0};
+        thread_local int index = next.fetch_add(1, std::memory_order_relaxed) % Slots;
+        return index;
+    }
+
+    Slot& claim() {
+        const int start = home();
+        SpinWait wait;
+        for (int i = 0;; ++i) {
+            const int index = (start + i) % Slots;
+            Slot& s = slots_[index];
+            std::uint32_t expected = kFree;
+            if (s.state.load(std::memory_order_relaxed) == kFree &&
+                s.state.compare_exchange_strong(expected, kClaimed, std::memory_order_acquire,
+                                                std::memory_order_relaxed)) {
+                int hw = high_water_.load(std::memory_order_relaxed);
+                while (hw < index + 1 &&
+                       !high_water_.compare_exchange_weak(hw, index + 1, std::memory_order_release)) {
+                }
+                return s;
+            }
+            if (i % Slots == Slots - 1) wait.pause();  // every slot busy
+        }
+    }
+
+    // Holder of locked_ only. A few passes, so operations published while
+    // the first one ran join this batch instead of waiting for the next.
+    void combine() {
+        std::uint64_t applied = 0;
+        for (int pass = 0; pass < kMaxPasses; ++pass) {
+            bool found = false;
+            const int n = high_water_.load(std::memory_order_acquire);
+            for (int i = 0; i < n; ++i) {
+                Slot& s = slots_[i];
+                if (s.state.load(std::memory_order_acquire) != kPending) continue;
+                s.run(state_, s.call);
+                s.state.store(kDone, std::memory_order_release);
+                ++applied;
+                found = true;
+            }
+            if (!found) break;
+        }
+        passes_.store(passes_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        applied_.store(applied_.load(std::memory_order_relaxed) + applied, std::memory_order_relaxed);
+    }
+
+    static constexpr int kMaxPasses = 3;
+
+    alignas(kCacheLineSize) std::atomic<bool> locked_{false};
+    std::atomic<int> high_water_{0};
+    // Written only by the combiner.
+    std::atomic<std::uint64_t> passes_{0}, applied_{0};
+    T state_;
+    Slot slots_[Slots];
+};
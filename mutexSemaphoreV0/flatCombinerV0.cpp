@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "flatCombiner.h"
+
+// Lock per operation (std::lock_guard<std::mutex>, as in mutexV0.cpp) vs
+// FlatCombiner, for three small shared structures:
+//   counter  ++counter
+//   queue    std::deque<long>: push_back, then pop_front on every 2nd op
+//   map      std::map<int, long> with 64 keys: ++m[key]
+// T threads each run `ops` operations; M ops/s, the combiner's average
+// batch size, and a checksum against the expected final state. Batches
+// only form while callers overlap on different cores; with one CPU the
+// combiner mostly runs its own operation alone (batch ~1).
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int kKeys = 64;
+
+struct Queue {
+    std::deque<long> items;
+    long popped = 0;  // sum of popped values
+};
+
+template <typename Body>
+double run(int threads, long ops, Body body) {
+    std::vector<std::thread> workers;
+    auto start = Clock::now();
+    for (int t = 0; t < threads; ++t)
+        workers.emplace_back([&, t] {
+            for (long i = 0; i < ops; ++i) body(t, i);
+        });
+    for (auto& w : workers) w.join();
+    std::chrono::duration<double> secs = Clock::now() - start;
+    return threads * ops / secs.count() / 1e6;
+}
+
+// Expected (popped + still queued) for the queue workload: every thread
+// pushes t * ops + i for each i.
+long queue_sum(int threads, long ops) {
+    long sum = 0;
+    for (int t = 0; t < threads; ++t) sum += t * ops * ops + ops * (ops - 1) / 2;
+    return sum;
+}
+
+long total(const Queue& q) {
+    long sum = q.popped;
+    for (long v : q.items) sum += v;
+    return sum;
+}
+
+long total(const std::map<int, long>& m) {
+    long sum = 0;
+    for (auto& kv : m) sum += kv.second;
+    return sum;
+}
+
+void print(const char* workload, int threads, double locked, double combined, double batch, bool ok) {
+    std::cout << workload << "\t" << threads << "\t" << locked << "\t" << combined << "\t" << batch
+              << (ok ? "" : "\tCHECKSUM MISMATCH") << "\n";
+}
+
+// ./flatCombinerV0 [max_threads] [ops_per_thread]
+int main(int argc, char** argv) {
+    int max_threads = argc > 1 ? std::atoi(argv[1]) : 8;
+    long ops = argc > 2 ? std::atol(argv[2]) : 200000;
+
+    std::cout << "workload\tthreads\tmutex M ops/s\tcombined M ops/s\tavg batch\n";
+    for (int threads = 1;; threads = std::min(threads * 2, max_threads)) {
+        {
+            std::mutex mtx;
+            long counter = 0;
+            double locked = run(threads, ops, [&](int, long) {
+                std::lock_guard<std::mutex> lock(mtx);
+                ++counter;
+            });
+            FlatCombiner<long> fc(0L);
+            double combined = run(threads, ops, [&](int, long) { fc.apply([](long& c) { ++c; }); });
+            print("counter", threads, locked, combined, fc.average_batch(),
+                  counter == threads * ops && fc.unsafe_state() == threads * ops);
+        }
+        {
+            std::mutex mtx;
+            Queue q;
+            double locked = run(threads, ops, [&](int t, long i) {
+                std::lock_guard<std::mutex> lock(mtx);
+                q.items.push_back(t * ops + i);
+                if (i % 2) {
+                    q.popped += q.items.front();
+                    q.items.pop_front();
+                }
+            });
+            FlatCombiner<Queue> fc;
+            double combined = run(threads, ops, [&](int t, long i) {
+                fc.apply([&](Queue& s) {
+                    s.items.push_back(t * ops + i);
+                    if (i % 2) {
+                        s.popped += s.items.front();
+                        s.items.pop_front();
+                    }
+                });
+            });
+            const long expect = queue_sum(threads, ops);
+            print("queue", threads, locked, combined, fc.average_batch(),
+                  total(q) == expect && total(fc.unsafe_state()) == expect);
+        }
+        {
+            std::mutex mtx;
+            std::map<int, long> m;
+            double locked = run(threads, ops, [&](int t, long i) {
+                std::lock_guard<std::mutex> lock(mtx);
+                ++m[static_cast<int>((t * 31 + i) % kKeys)];
+            });
+            FlatCombiner<std::map<int, long>> fc;
+            double combined = run(threads, ops, [&](int t, long i) {
+                const int key = static_cast<int>((t * 31 + i) % kKeys);
+                fc.apply([key](std::map<int, long>& s) { ++s[key]; });
+            });
+            print("map", threads, locked, combined, fc.average_batch(),
+                  total(m) == threads * ops && total(fc.unsafe_state()) == threads * ops);
+        }
+        if (threads >= max_threads) break;
+    }
+    return 0;
+}
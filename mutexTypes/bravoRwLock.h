@@ -0,0 +1,168 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <thread>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#include "../producerConsumerV0/cacheLine.h"
+
+// Reader-writer lock whose readers do not share a cache line
+// (after BRAVO, Dice & Kogan, USENIX ATC 2019).
+//
+// std::shared_mutex in sharedMutexV0.cpp keeps one reader count; every
+// lock_shared/unlock_shared from every core is an RMW on it. Here, while the
+// lock is "reader-biased", a reader only increments the slot of the CPU it
+// runs on (slots are cache-line padded) and re-checks the bias:
+//
+//   reader: ++slot[cpu]; if (bias) done; else --slot[cpu] and take the
+//           underlying shared_mutex in shared mode
+//   writer: take the underlying shared_mutex exclusively; if biased, clear
+//           the bias and wait until every slot drains
+//
+// Revoking the bias costs the writer a scan of all slots, so after a
+// revocation the bias stays off for kInhibitFactor times as long as the
+// revocation took; readers in that window use the shared_mutex and the
+// first one after it re-enables the bias. Read-mostly workloads stay on the
+// fast path; write-heavy ones degrade to a plain shared_mutex.
+//
+// Drop-in for std::shared_mutex: lock/try_lock/unlock and
+// lock_shared/try_lock_shared/unlock_shared, so std::unique_lock and
+// std::shared_lock work. A thread may hold at most kMaxFastHolds read locks
+// via the fast path at once (more fall back to the slow path).
+class BravoRwLock {
+public:
+    BravoRwLock() : slots_count_(slot_count()), slots_(new Slot[slots_count_]) {}
+    BravoRwLock(const BravoRwLock&) = delete;
+    BravoRwLock& operator=(const BravoRwLock&) = delete;
+
+    void lock_shared() {
+        if (try_fast_read()) return;
+        rw_.lock_shared();
+        maybe_restore_bias();
+    }
+
+    bool try_lock_shared() {
+        if (try_fast_read()) return true;
+        if (!rw_.try_lock_shared()) return false;
+        maybe_restore_bias();
+        return true;
+    }
+
+    void unlock_shared() {
+        FastHolds& holds = fast_holds();
+        for (int i = holds.count - 1; i >= 0; --i)
+            if (holds.entries[i].lock == this) {
+                slots_[holds.entries[i].slot].readers.fetch_sub(1, std::memory_order_release);
+                holds.entries[i] = holds.entries[--holds.count];
+                return;
+            }
+        rw_.unlock_shared();
+    }
+
+    void lock() {
+        rw_.lock();
+        revoke_bias();
+    }
+
+    bool try_lock() {
+        if (!rw_.try_lock()) return false;
+        revoke_bias();
+        return true;
+    }
+
+    void unlock() { rw_.unlock(); }
+
+private:
+    static constexpr int kMaxFastHolds = 8;
+    static constexpr int kInhibitFactor = 9;  // BRAVO's N
+
+    struct alignas(kCacheLineSize) Slot {
+        std::atomic<std::int32_t> readers{0};
+    };
+
+    struct FastHolds {
+        struct Entry {
+            const BravoRwLock* lock;
+            std::size_t slot;
+        };
+        Entry entries[kMaxFastHolds];
+        int count = 0;
+    };
+    static FastHolds& fast_holds() {
+        thread_local FastHolds h;
+        return h;
+    }
+
+    static std::size_t slot_count() {
+        std::size_t n = 1;
+        while (n < std::thread::hardware_concurrency()) n <<= 1;
+        return n;
+    }
+
+    // The CPU we run on; threads that migrate between lock and unlock still
+    // release the slot they incremented (it is remembered in FastHolds).
+    std::size_t my_slot() const {
+#if defined(__linux__)
+        const int cpu = sched_getcpu();
+        if (cpu >= 0) return static_cast<std::size_t>(cpu) & (slots_count_ - 1);
+#endif
+        static std::atomic<std::size_t> next{0};
+        thread_local const std::size_t slot = next.fetch_add(1, std::memory_order_relaxed);
+        return slot & (slots_count_ - 1);
+    }
+
+    bool try_fast_read() {
+        if (!bias_.load(std::memory_order_acquire)) return false;
+        FastHolds& holds = fast_holds();
+        if (holds.count == kMaxFastHolds) return false;
+        const std::size_t slot = my_slot();
+        // seq_cst increment then seq_cst re-check, against the writer's
+        // seq_cst clear then scan: one of the two sees the other.
+        slots_[slot].readers.fetch_add(1, std::memory_order_seq_cst);
+        if (bias_.load(std::memory_order_seq_cst)) {
+            holds.entries[holds.count++] = {this, slot};
+            return true;
+        }
+        slots_[slot].readers.fetch_sub(1, std::memory_order_release);
+        return false;
+    }
+
+    // Writer holds rw_ exclusively.
+    void revoke_bias() {
+        if (!bias_.load(std::memory_order_relaxed)) return;
+        const auto start = std::chrono::steady_clock::now();
+        bias_.store(false, std::memory_order_seq_cst);
+        for (std::size_t i = 0; i < slots_count_; ++i)
+            for (int spins = 0; slots_[i].readers.load(std::memory_order_seq_cst) != 0; ++spins) {
+                if (spins < 64) cpu_relax();
+                else std::this_thread::yield();
+            }
+        const auto now = std::chrono::steady_clock::now();
+        inhibit_until_ns_.store(ns(now + (now - start) * kInhibitFactor), std::memory_order_relaxed);
+    }
+
+    // Reader holds rw_ shared, so no writer is between revoke and unlock.
+    void maybe_restore_bias() {
+        if (bias_.load(std::memory_order_relaxed)) return;
+        if (ns(std::chrono::steady_clock::now()) >= inhibit_until_ns_.load(std::memory_order_relaxed))
+            bias_.store(true, std::memory_order_release);
+    }
+
+    static std::int64_t ns(std::chrono::steady_clock::time_point t) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+    }
+
+    alignas(kCacheLineSize) std::atomic<bool> bias_{true};
+    std::atomic<std::int64_t> inhibit_until_ns_{0};
+    const std::size_t slots_count_;
+    const std::unique_ptr<Slot[]> slots_;
+    std::shared_mutex rw_;
+};
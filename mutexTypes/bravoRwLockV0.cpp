@@ -0,0 +1,68 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+
+#include "../casTasV0/timedRun.h"
+#include "bravoRwLock.h"
+
+// Reader scaling, 1..max_threads readers, for
+//   shared_mutex  std::shared_mutex (one shared reader count)
+//   bravo         BravoRwLock (per-CPU reader slots)
+// Each reader takes a std::shared_lock and sums a small table. In the second
+// table one writer thread also takes the lock exclusively every
+// `write_every_us` microseconds and bumps the table, which revokes the
+// bias. Readers check that the table is never seen half-updated.
+
+struct Table {
+    std::uint64_t v[8] = {};
+};
+
+template <typename Lock>
+TimedRun::Result run(int readers, bool writer, int write_every_us, std::chrono::milliseconds duration) {
+    Lock lock;
+    Table table;
+    TimedRun bench;
+    bench.workers(readers, [&](int) {
+        return [&] {
+            std::shared_lock<Lock> guard(lock);
+            std::uint64_t first = table.v[0], sum = 0;
+            for (auto x : table.v) sum += x;
+            return sum == first * 8;
+        };
+    });
+    if (writer)
+        bench.background([&](const std::atomic<bool>& stop) {
+            while (!stop.load(std::memory_order_relaxed)) {
+                {
+                    std::unique_lock<Lock> guard(lock);
+                    for (auto& x : table.v) ++x;
+                }
+                std::this_thread::sleep_for(std::chrono::microseconds(write_every_us));
+            }
+        });
+    return bench.finish(duration);
+}
+
+// ./bravoRwLockV0 [max_readers] [ms_per_run] [write_every_us]
+int main(int argc, char** argv) {
+    int max_readers = argc > 1 ? std::atoi(argv[1]) : 64;
+    std::chrono::milliseconds duration(argc > 2 ? std::atoi(argv[2]) : 200);
+    int write_every_us = argc > 3 ? std::atoi(argv[3]) : 1000;
+
+    for (bool writer : {false, true}) {
+        if (writer) std::cout << "\nplus one writer every " << write_every_us << " us\n";
+        std::cout << "readers\tshared_mutex\tbravo   (M reads/s)\n";
+        doubling(max_readers, [&](int readers) {
+            auto sm = run<std::shared_mutex>(readers, writer, write_every_us, duration);
+            auto br = run<BravoRwLock>(readers, writer, write_every_us, duration);
+            std::cout << readers << "\t" << sm.ops_per_sec / 1e6 << "\t" << br.ops_per_sec / 1e6
+                      << (sm.ok && br.ok ? "" : "\tTORN READ") << "\n";
+        });
+    }
+    return 0;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+// Recursive mutex whose re-entry is a plain increment.
+//
+// recursive_function in recursiveMutexV0.cpp calls rmtx.lock() at every
+// level; std::recursive_mutex goes through pthread's owner check and an
+// atomic on each of them. Here the owner is cached next to an inline depth:
+//
+//   lock():   owner_ == me ? ++depth_             (no atomic RMW)
+//                          : inner_.lock(), owner_ = me, depth_ = 1
+//   unlock(): --depth_ == 0 ? owner_ = none, inner_.unlock() : nothing
+//
+// so only the outermost lock/unlock touch the underlying mutex. owner_ is
+// read with a relaxed load: the only thread that can ever see its own token
+// there is the one that stored it, so a stale value only ever reads as
+// "not me".
+//
+// Mutex is any Lockable (std::mutex by default, FutexTimedMutex, a
+// spinlock...). Satisfies Lockable, so it works with std::lock_guard.
+template <typename Mutex = std::mutex>
+class FastRecursiveMutex {
+public:
+    FastRecursiveMutex() = default;
+    FastRecursiveMutex(const FastRecursiveMutex&) = delete;
+    FastRecursiveMutex& operator=(const FastRecursiveMutex&) = delete;
+
+    void lock() {
+        const std::uintptr_t me = self();
+        if (owner_.load(std::memory_order_relaxed) == me) {
+            ++depth_;
+            return;
+        }
+        inner_.lock();
+        owner_.store(me, std::memory_order_relaxed);
+        depth_ = 1;
+    }
+
+    bool try_lock() {
+        const std::uintptr_t me = self();
+        if (owner_.load(std::memory_order_relaxed) == me) {
+            ++depth_;
+            return true;
+        }
+        if (!inner_.try_lock()) return false;
+        owner_.store(me, std::memory_order_relaxed);
+        depth_ = 1;
+        return true;
+    }
+
+    // Caller must own the lock.
+    void unlock() {
+        if (--depth_ != 0) return;
+        owner_.store(0, std::memory_order_relaxed);
+        inner_.unlock();
+    }
+
+    // Only meaningful for the owning thread.
+    unsigned depth() const { return depth_; }
+
+private:
+    // A per-thread address: unique among live threads and never 0.
+    static std::uintptr_t self() {
+        thread_local char token;
+        return reinterpret_cast<std::uintptr_t>(&token);
+    }
+
+    std::atomic<std::uintptr_t> owner_{0};
+    unsigned depth_ = 0;  // only touched by the owner
+    Mutex inner_;
+};
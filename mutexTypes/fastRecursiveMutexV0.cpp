@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "fastRecursiveMutex.h"
+
+// std::recursive_mutex vs FastRecursiveMutex<std::mutex>:
+// 1. Deep re-entry: one thread runs recursive_function (as in
+//    recursiveMutexV0.cpp, minus the printing) to depth D; ns per level.
+//    Past ~32 levels the CPU's return-stack buffer overflows and the
+//    mispredicted returns cost more than either lock.
+// 2. Contended first acquisition: T threads each lock, re-enter 3 more
+//    levels, bump a shared counter and unlock; M outer acquisitions/s.
+// A second thread is alive during (1) so glibc does not take its
+// single-threaded shortcut in either lock.
+
+using Clock = std::chrono::steady_clock;
+
+template <typename Lock>
+void recursive_function(Lock& lock, int count, long& work) {
+    if (count <= 0) return;
+    lock.lock();
+    ++work;
+    recursive_function(lock, count - 1, work);
+    lock.unlock();
+}
+
+template <typename Lock>
+double ns_per_level(int depth, long calls) {
+    Lock lock;
+    long work = 0;
+    auto start = Clock::now();
+    for (long i = 0; i < calls; ++i) recursive_function(lock, depth, work);
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    if (work != calls * depth) std::abort();
+    return ns / (calls * depth);
+}
+
+template <typename Lock>
+double contended(int threads, long per_thread, bool& ok) {
+    Lock lock;
+    long counter = 0;
+    std::vector<std::thread> workers;
+    auto start = Clock::now();
+    for (int t = 0; t < threads; ++t)
+        workers.emplace_back([&] {
+            long work = 0;
+            for (long i = 0; i < per_thread; ++i) {
+                std::lock_guard<Lock> outer(lock);
+                recursive_function(lock, 3, work);
+                ++counter;
+            }
+        });
+    for (auto& w : workers) w.join();
+    std::chrono::duration<double> secs = Clock::now() - start;
+    ok &= counter == threads * per_thread;
+    return threads * per_thread / secs.count();
+}
+
+// ./fastRecursiveMutexV0 [max_threads] [ops]
+int main(int argc, char** argv) {
+    int max_threads = argc > 1 ? std::atoi(argv[1]) : 8;
+    long ops = argc > 2 ? std::atol(argv[2]) : 1000000;
+
+    std::atomic<bool> done{false};
+    std::thread idle([&] {
+        while (!done) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    });
+    std::cout << "depth\trecursive_mutex\tfast   (ns per level)\n";
+    for (int depth : {1, 4, 16, 64}) {
+        long calls = std::max(1L, ops / depth);
+        std::cout << depth << "\t" << ns_per_level<std::recursive_mutex>(depth, calls) << "\t"
+                  << ns_per_level<FastRecursiveMutex<>>(depth, calls) << "\n";
+    }
+    done = true;
+    idle.join();
+
+    std::cout << "\nthreads\trecursive_mutex\tfast   (M outer acquisitions/s, depth 4)\n";
+    for (int threads = 1;; threads = std::min(threads * 2, max_threads)) {
+        bool ok = true;
+        double r = contended<std::recursive_mutex>(threads, ops / 4, ok);
+        double f = contended<FastRecursiveMutex<>>(threads, ops / 4, ok);
+        std::cout << threads << "\t" << r / 1e6 << "\t" << f / 1e6 << (ok ? "" : "\tWRONG COUNT") << "\n";
+        if (threads >= max_threads) break;
+    }
+    return 0;
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#if !defined(__linux__)
+#error "futexTimedMutex.h needs Linux futexes"
+#endif
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <type_traits>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Timed mutex on one futex word (Drepper, "Futexes Are Tricky", mutex 2).
+//
+// std::timed_mutex::try_lock_for in timedMutexV0.cpp is heavier than
+// std::mutex even uncontended on the libstdc++ we ship. This one has the
+// same fast path as a plain futex mutex, one CAS to lock and one RMW to
+// unlock, and a timed wait that hands the absolute deadline to the kernel
+// (FUTEX_WAIT_BITSET), so a waiter sleeps exactly once per wake-up with no
+// polling loop and no relative-timeout drift.
+//
+//   FutexTimedMutex m;
+//   if (m.try_lock_for(std::chrono::milliseconds(100))) { ...; m.unlock(); }
+//   if (m.try_lock_until(deadline)) ...        // steady_clock: CLOCK_MONOTONIC
+//                                              // system_clock: CLOCK_REALTIME
+//
+// State: 0 unlocked, 1 locked, 2 locked and someone may be sleeping. Only an
+// unlock that sees 2 makes the wake syscall. Satisfies TimedLockable, so it
+// works with std::unique_lock(m, timeout).
+class FutexTimedMutex {
+public:
+    FutexTimedMutex() = default;
+    FutexTimedMutex(const FutexTimedMutex&) = delete;
+    FutexTimedMutex& operator=(const FutexTimedMutex&) = delete;
+
+    void lock() {
+        std::uint32_t c = 0;
+        if (state_.compare_exchange_strong(c, 1, std::memory_order_acquire, std::memory_order_relaxed)) return;
+        if (c != 2) c = state_.exchange(2, std::memory_order_acquire);
+        while (c != 0) {
+            wait(nullptr, 0);
+            c = state_.exchange(2, std::memory_order_acquire);
+        }
+    }
+
+    bool try_lock() {
+        std::uint32_t c = 0;
+        return state_.compare_exchange_strong(c, 1, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    template <typename Rep, typename Period>
+    bool try_lock_for(const std::chrono::duration<Rep, Period>& timeout) {
+        if (try_lock()) return true;  // no clock read when uncontended
+        return try_lock_until(std::chrono::steady_clock::now() + timeout);
+    }
+
+    template <typename Clock, typename Duration>
+    bool try_lock_until(const std::chrono::time_point<Clock, Duration>& deadline) {
+        if (try_lock()) return true;
+        int clock_flag = 0;
+        timespec abs;
+        if (std::is_same<Clock, std::chrono::steady_clock>::value) {
+            abs = to_timespec(deadline.time_since_epoch());
+        } else if (std::is_same<Clock, std::chrono::system_clock>::value) {
+            abs = to_timespec(deadline.time_since_epoch());
+            clock_flag = FUTEX_CLOCK_REALTIME;
+        } else {  // other clocks: convert once to steady_clock
+            abs = to_timespec((std::chrono::steady_clock::now() + (deadline - Clock::now())).time_since_epoch());
+        }
+
+        std::uint32_t c = state_.exchange(2, std::memory_order_acquire);
+        while (c != 0) {
+            if (wait(&abs, clock_flag) == ETIMEDOUT) return false;
+            c = state_.exchange(2, std::memory_order_acquire);
+        }
+        return true;
+    }
+
+    void unlock() {
+        if (state_.exchange(0, std::memory_order_release) == 2) wake();
+    }
+
+private:
+    template <typename Duration>
+    static timespec to_timespec(Duration since_epoch) {
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch).count();
+        timespec ts;
+        ts.tv_sec = ns > 0 ? static_cast<time_t>(ns / 1000000000) : 0;
+        ts.tv_nsec = ns > 0 ? static_cast<long>(ns % 1000000000) : 0;
+        return ts;
+    }
+
+    // Sleeps while the state is 2, until `abs` if given. Returns errno
+    // (ETIMEDOUT once the deadline has passed), 0 on wake-up.
+    int wait(const timespec* abs, int clock_flag) {
+        const long r = syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&state_),
+                               FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG | clock_flag, 2u, abs, nullptr,
+                               FUTEX_BITSET_MATCH_ANY);
+        return r == 0 ? 0 : errno;
+    }
+
+    void wake() {
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&state_), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+    }
+
+    std::atomic<std::uint32_t> state_{0};
+};
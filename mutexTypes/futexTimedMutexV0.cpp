@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "futexTimedMutex.h"
+
+// 1. Uncontended cost (ns per lock + unlock pair, one thread):
+//      std::mutex lock, std::timed_mutex lock / try_lock_for(100ms),
+//      FutexTimedMutex lock / try_lock_for(100ms)
+//    An idle second thread is kept alive meanwhile: glibc drops the lock
+//    prefix from its mutexes while a process is single-threaded, which would
+//    flatter std::mutex compared with any real program.
+// 2. Timeout accuracy: another thread holds the lock, we call
+//    try_lock_for(d) `samples` times and record how late it returns
+//    (elapsed - d); p50 / p99 / max overshoot in microseconds.
+
+using Clock = std::chrono::steady_clock;
+
+template <typename Body>
+double ns_per_op(long n, Body body) {
+    auto start = Clock::now();
+    for (long i = 0; i < n; ++i) body();
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / n;
+}
+
+template <typename Mutex>
+std::vector<double> overshoot_us(std::chrono::microseconds d, int samples) {
+    Mutex m;
+    m.lock();  // held by this thread for the whole measurement
+    std::vector<double> late;
+    std::thread waiter([&] {
+        for (int i = 0; i < samples; ++i) {
+            auto start = Clock::now();
+            if (m.try_lock_for(d)) std::abort();  // nobody unlocks
+            late.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start - d).count());
+        }
+    });
+    waiter.join();
+    m.unlock();
+    std::sort(late.begin(), late.end());
+    return late;
+}
+
+// ./futexTimedMutexV0 [uncontended_ops] [timeout_samples]
+int main(int argc, char** argv) {
+    long n = argc > 1 ? std::atol(argv[1]) : 20000000;
+    int samples = argc > 2 ? std::atoi(argv[2]) : 200;
+    if (n < 1 || samples < 1) {
+        std::cerr << "uncontended_ops and timeout_samples must be at least 1\n";
+        return 1;
+    }
+    const auto timeout = std::chrono::milliseconds(100);
+
+    std::mutex mtx;
+    std::timed_mutex tmtx;
+    FutexTimedMutex fmtx;
+    std::atomic<bool> done{false};
+    std::thread idle([&] {
+        while (!done) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    });
+    std::cout << "uncontended lock+unlock (ns)\n";
+    std::cout << "std::mutex lock\t" << ns_per_op(n, [&] { mtx.lock(); mtx.unlock(); }) << "\n";
+    std::cout << "std::timed_mutex lock\t" << ns_per_op(n, [&] { tmtx.lock(); tmtx.unlock(); }) << "\n";
+    std::cout << "std::timed_mutex try_lock_for\t"
+              << ns_per_op(n, [&] { if (tmtx.try_lock_for(timeout)) tmtx.unlock(); }) << "\n";
+    std::cout << "FutexTimedMutex lock\t" << ns_per_op(n, [&] { fmtx.lock(); fmtx.unlock(); }) << "\n";
+    std::cout << "FutexTimedMutex try_lock_for\t"
+              << ns_per_op(n, [&] { if (fmtx.try_lock_for(timeout)) fmtx.unlock(); }) << "\n";
+    done = true;
+    idle.join();
+
+    std::cout << "\ntimeout overshoot (us)\ntimeout\tmutex\tp50\tp99\tmax\n";
+    for (int us : {100, 1000, 10000}) {
+        auto print = [&](const char* name, const std::vector<double>& late) {
+            std::cout << us << "us\t" << name << "\t" << late[late.size() / 2] << "\t"
+                      << late[std::min(late.size() - 1, late.size() * 99 / 100)] << "\t" << late.back() << "\n";
+        };
+        const int k = us >= 10000 ? std::max(10, samples / 10) : samples;
+        print("std::timed_mutex", overshoot_us<std::timed_mutex>(std::chrono::microseconds(us), k));
+        print("FutexTimedMutex", overshoot_us<FutexTimedMutex>(std::chrono::microseconds(us), k));
+    }
+    return 0;
+}
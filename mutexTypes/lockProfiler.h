@@ -0,0 +1,287 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "../casTasV0/threadHistogram.h"
+
+// Profiling decorator for any lock type.
+//
+//   ProfiledLock<std::mutex> mtx{LOCK_SITE("print_safe")};
+//   std::lock_guard<ProfiledLock<std::mutex>> g(mtx);   // used like the lock
+//   ...
+//   lockprof::report(std::cout);
+//
+// Wraps std::mutex, recursive_mutex, timed_mutex, shared_mutex, the
+// spinlocks in casTasV0/spinlocks.h or anything else Lockable; only the
+// members the wrapped type has can be called (lock_shared, try_lock_for...).
+// Per site (the LOCK_SITE tag given at construction: a name plus file:line)
+// it records:
+//   acquisitions      every successful lock / try_lock / lock_shared
+//   contended         acquisitions whose first try_lock failed
+//   wait histogram    time blocked in contended acquisitions
+//   hold histogram    time from the outermost acquire to its release; every
+//                     contended acquisition, and one in kHoldSampleEvery
+//                     uncontended ones (counted per thread and site)
+//
+// Cost when uncontended: one try_lock instead of lock, one thread_local
+// lookup and a handful of stores to the calling thread's own buffer; no
+// shared writes and no locks. Timing the hold takes two timestamp reads
+// (rdtsc on x86, steady_clock elsewhere), which would dominate (~20 ns each
+// under virtualization), hence the sampling. Ticks are
+// converted to ns only when the report is printed. Histograms are the
+// per-thread log2 buckets of casTasV0/threadHistogram.h; the report gives
+// bucket upper bounds, clamped to the recorded max.
+
+namespace lockprof {
+
+constexpr int kMaxSites = 64;
+constexpr std::uint64_t kHoldSampleEvery = 8;
+
+inline std::uint64_t ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                          std::chrono::steady_clock::now().time_since_epoch())
+                                          .count());
+#endif
+}
+
+// ns per tick, measured once against steady_clock.
+inline double ns_per_tick() {
+#if defined(__x86_64__) || defined(__i386__)
+    static const double v = [] {
+        const auto c0 = std::chrono::steady_clock::now();
+        const std::uint64_t t0 = ticks();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        const std::uint64_t t1 = ticks();
+        const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - c0).count();
+        return t1 > t0 ? ns / static_cast<double>(t1 - t0) : 1.0;
+    }();
+    return v;
+#else
+    return 1.0;
+#endif
+}
+
+// One thread's counters for one site; times in ticks.
+struct SiteStats {
+    std::atomic<std::uint64_t> acquisitions{0}, contended{0};
+    threadhist::Histogram wait, hold;
+
+    void merge(const SiteStats& o) {
+        threadhist::Histogram::bump(acquisitions, o.acquisitions.load(std::memory_order_relaxed));
+        threadhist::Histogram::bump(contended, o.contended.load(std::memory_order_relaxed));
+        wait.merge(o.wait);
+        hold.merge(o.hold);
+    }
+};
+
+using Sites = threadhist::SiteRegistry<SiteStats, kMaxSites>;
+
+inline SiteStats& stats(int site) { return Sites::instance().local(site); }
+
+// Registers (or finds) a site name and returns its id.
+inline int register_site(const std::string& name) { return Sites::instance().site(name); }
+
+struct Site {
+    int id;
+};
+
+// Shared-mode hold start times: several threads may hold the lock shared.
+struct SharedHolds {
+    static constexpr int kMax = 8;
+    const void* lock[kMax] = {};
+    std::uint64_t since[kMax] = {};
+    int count = 0;
+};
+inline SharedHolds& shared_holds() {
+    thread_local SharedHolds h;
+    return h;
+}
+
+// Merges all threads and prints one row per site, times in ns.
+inline void report(std::ostream& os) {
+    const double k = ns_per_tick();
+    auto ns = [k](std::uint64_t t) { return static_cast<std::uint64_t>(t * k); };
+    auto times = [&](const threadhist::Histogram& h) {
+        os << ns(h.quantile(0.5)) << "/" << ns(h.quantile(0.99)) << "/" << ns(h.max.load(std::memory_order_relaxed));
+    };
+    os << "site\tacquisitions\tcontended\twait p50/p99/max ns\thold p50/p99/max ns\n";
+    Sites::instance().for_each_site([&](const std::string& name, const SiteStats& total) {
+        const std::uint64_t n = total.acquisitions.load(std::memory_order_relaxed);
+        if (n == 0) return;
+        os << name << "\t" << n << "\t" << total.contended.load(std::memory_order_relaxed) << "\t";
+        times(total.wait);
+        os << "\t";
+        times(total.hold);
+        os << "\n";
+    });
+}
+
+}  // namespace lockprof
+
+#define LOCKPROF_STR2(x) #x
+#define LOCKPROF_STR(x) LOCKPROF_STR2(x)
+// Site tag for a ProfiledLock: "name (file:line)".
+#define LOCK_SITE(name) \
+    ::lockprof::Site { ::lockprof::register_site(std::string(name) + " (" __FILE__ ":" LOCKPROF_STR(__LINE__) ")") }
+
+template <typename Lock>
+class ProfiledLock {
+public:
+    explicit ProfiledLock(lockprof::Site site) : site_(site.id) {}
+    ProfiledLock(const ProfiledLock&) = delete;
+    ProfiledLock& operator=(const ProfiledLock&) = delete;
+
+    // A contended acquire reads the clock once more after waiting; that
+    // reading ends the wait and starts the hold.
+    void lock() {
+        if (inner_.try_lock()) {
+            acquired();
+            return;
+        }
+        const std::uint64_t t0 = lockprof::ticks();
+        inner_.lock();
+        const std::uint64_t now = lockprof::ticks();
+        acquired(now, now - t0);
+    }
+
+    bool try_lock() {
+        if (!inner_.try_lock()) return false;
+        acquired();
+        return true;
+    }
+
+    template <typename Duration>
+    bool try_lock_for(const Duration& d) {
+        if (inner_.try_lock()) {
+            acquired();
+            return true;
+        }
+        const std::uint64_t t0 = lockprof::ticks();
+        if (!inner_.try_lock_for(d)) return false;
+        const std::uint64_t now = lockprof::ticks();
+        acquired(now, now - t0);
+        return true;
+    }
+
+    template <typename TimePoint>
+    bool try_lock_until(const TimePoint& t) {
+        if (inner_.try_lock()) {
+            acquired();
+            return true;
+        }
+        const std::uint64_t t0 = lockprof::ticks();
+        if (!inner_.try_lock_until(t)) return false;
+        const std::uint64_t now = lockprof::ticks();
+        acquired(now, now - t0);
+        return true;
+    }
+
+    void unlock() {
+        // depth_ > 1 only for recursive locks re-entered by the owner.
+        if (--depth_ == 0 && timed_) holder_stats_->hold.record(lockprof::ticks() - held_since_);
+        inner_.unlock();
+    }
+
+    void lock_shared() {
+        if (inner_.try_lock_shared()) {
+            acquired_shared();
+            return;
+        }
+        const std::uint64_t t0 = lockprof::ticks();
+        inner_.lock_shared();
+        const std::uint64_t now = lockprof::ticks();
+        acquired_shared(now, now - t0);
+    }
+
+    bool try_lock_shared() {
+        if (!inner_.try_lock_shared()) return false;
+        acquired_shared();
+        return true;
+    }
+
+    void unlock_shared() {
+        lockprof::SharedHolds& h = lockprof::shared_holds();
+        for (int i = h.count - 1; i >= 0; --i)
+            if (h.lock[i] == this) {
+                lockprof::SiteStats& s = lockprof::stats(site_);
+                s.hold.record(lockprof::ticks() - h.since[i]);
+                h.lock[i] = h.lock[h.count - 1];
+                h.since[i] = h.since[h.count - 1];
+                --h.count;
+                break;
+            }
+        inner_.unlock_shared();
+    }
+
+    Lock& underlying() { return inner_; }
+
+private:
+    // Uncontended: counts it, and samples the hold time.
+    void acquired() {
+        lockprof::SiteStats& s = lockprof::stats(site_);
+        const bool timed = count(s, false) % lockprof::kHoldSampleEvery == 0;
+        if (depth_++ == 0) start_hold(s, timed, timed ? lockprof::ticks() : 0);
+    }
+
+    // Contended: `now` is when the wait of `waited` ticks ended.
+    void acquired(std::uint64_t now, std::uint64_t waited) {
+        lockprof::SiteStats& s = lockprof::stats(site_);
+        count(s, true);
+        s.wait.record(waited);
+        if (depth_++ == 0) start_hold(s, true, now);
+    }
+
+    void acquired_shared() {
+        lockprof::SiteStats& s = lockprof::stats(site_);
+        if (count(s, false) % lockprof::kHoldSampleEvery == 0) push_shared_hold(lockprof::ticks());
+    }
+
+    void acquired_shared(std::uint64_t now, std::uint64_t waited) {
+        lockprof::SiteStats& s = lockprof::stats(site_);
+        count(s, true);
+        s.wait.record(waited);
+        push_shared_hold(now);
+    }
+
+    // Returns this thread's acquisition count for the site, this one included.
+    static std::uint64_t count(lockprof::SiteStats& s, bool contended) {
+        const std::uint64_t n = s.acquisitions.load(std::memory_order_relaxed) + 1;
+        s.acquisitions.store(n, std::memory_order_relaxed);
+        if (contended) threadhist::Histogram::bump(s.contended, 1);
+        return n;
+    }
+
+    void start_hold(lockprof::SiteStats& s, bool timed, std::uint64_t now) {
+        holder_stats_ = &s;  // the holder's buffer, so unlock() skips the lookup
+        timed_ = timed;
+        held_since_ = now;
+    }
+
+    void push_shared_hold(std::uint64_t now) {
+        lockprof::SharedHolds& h = lockprof::shared_holds();
+        if (h.count < lockprof::SharedHolds::kMax) {  // deeper nesting is counted but not timed
+            h.lock[h.count] = this;
+            h.since[h.count++] = now;
+        }
+    }
+
+    Lock inner_;
+    const int site_;
+    // Exclusive-mode state, only touched by the holder.
+    unsigned depth_ = 0;
+    std::uint64_t held_since_ = 0;
+    lockprof::SiteStats* holder_stats_ = nullptr;
+    bool timed_ = false;
+};
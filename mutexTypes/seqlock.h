@@ -0,0 +1,113 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+#include "../producerConsumerV0/cacheLine.h"
+
+// Seqlock for small, read-mostly snapshots (config, counters, positions).
+//
+// A std::shared_lock in sharedMutexV0.cpp's reader() still writes the
+// lock's reader count, so readers on different cores fight over that line.
+// Here readers write nothing shared: a writer makes the sequence odd,
+// updates the data and makes it even again; a reader copies the data
+// between two reads of the sequence and retries if they differ or are odd.
+//
+//   SeqLock<Config> cfg(initial);
+//   Config c = cfg.load();                  // readers: never block writers
+//   cfg.store(next);                        // writers: serialised by a CAS on seq
+//   cfg.update([](Config& c) { ++c.epoch; });
+//
+// T must be trivially copyable. The data is kept as an array of atomic
+// words copied with relaxed loads/stores, so a reader racing a writer gets
+// a torn copy it then discards rather than a C++ data race. Readers can be
+// starved by a continuous stream of writers; that is the trade-off.
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock needs a trivially copyable T");
+
+public:
+    explicit SeqLock(const T& initial = T{}) { write_words(initial); }
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    // One attempt; false if a writer was active.
+    bool try_load(T& out) const {
+        const std::uint64_t before = seq_.load(std::memory_order_acquire);
+        if (before & 1) return false;
+        Word words[kWords];
+        for (std::size_t i = 0; i < kWords; ++i) words[i] = data_[i].load(std::memory_order_relaxed);
+        // Keeps the data loads above from moving below the re-check.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq_.load(std::memory_order_relaxed) != before) return false;
+        std::memcpy(&out, words, sizeof(T));
+        return true;
+    }
+
+    T load() const {
+        T out;
+        for (int spins = 0; !try_load(out); ++spins) backoff(spins);
+        return out;
+    }
+
+    void store(const T& value) {
+        const std::uint64_t seq = begin_write();
+        write_words(value);
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    // Read-modify-write under the writer side.
+    template <typename F>
+    void update(F f) {
+        const std::uint64_t seq = begin_write();
+        Word words[kWords];
+        for (std::size_t i = 0; i < kWords; ++i) words[i] = data_[i].load(std::memory_order_relaxed);
+        T value;
+        std::memcpy(&value, words, sizeof(T));
+        f(value);
+        write_words(value);
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    // Number of completed writes (for diagnostics).
+    std::uint64_t version() const { return seq_.load(std::memory_order_acquire) >> 1; }
+
+private:
+    using Word = std::uint64_t;
+    static constexpr std::size_t kWords = (sizeof(T) + sizeof(Word) - 1) / sizeof(Word);
+
+    // Takes the writer side (even -> odd) and returns the even value.
+    std::uint64_t begin_write() {
+        std::uint64_t seq = seq_.load(std::memory_order_relaxed);
+        for (int spins = 0;; ++spins) {
+            if (!(seq & 1) && seq_.compare_exchange_weak(seq, seq + 1, std::memory_order_acquire,
+                                                         std::memory_order_relaxed))
+                break;
+            backoff(spins);
+            seq = seq_.load(std::memory_order_relaxed);
+        }
+        // Orders the odd sequence before the data stores that follow.
+        std::atomic_thread_fence(std::memory_order_release);
+        return seq;
+    }
+
+    // A writer holds the odd sequence for a few stores; if it is not done
+    // after a short spin it was probably preempted, so give up the core.
+    static void backoff(int spins) {
+        if (spins < 64) cpu_relax();
+        else std::this_thread::yield();
+    }
+
+    void write_words(const T& value) {
+        Word words[kWords] = {};
+        std::memcpy(words, &value, sizeof(T));
+        for (std::size_t i = 0; i < kWords; ++i) data_[i].store(words[i], std::memory_order_relaxed);
+    }
+
+    alignas(kCacheLineSize) std::atomic<std::uint64_t> seq_{0};
+    std::atomic<Word> data_[kWords];
+};
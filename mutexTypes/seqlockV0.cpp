@@ -0,0 +1,89 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <shared_mutex>
+
+#include "../casTasV0/timedRun.h"
+#include "seqlock.h"
+
+// Read-mostly snapshot: `threads` threads each loop for a fixed time, doing
+// a write with probability `write_pct`% and otherwise a read, against
+//   shared_mutex  std::shared_lock / std::unique_lock, as in sharedMutexV0.cpp
+//   seqlock       SeqLock<Snapshot>
+// Reported: M ops/s for each. Readers verify that every field of the
+// snapshot they saw belongs to the same version (no torn reads).
+
+struct Snapshot {
+    std::uint64_t version = 0;
+    std::uint64_t fields[6] = {};
+    bool consistent() const {
+        for (int i = 0; i < 6; ++i)
+            if (fields[i] != version * (i + 2)) return false;
+        return true;
+    }
+    static Snapshot of(std::uint64_t v) {
+        Snapshot s;
+        s.version = v;
+        for (int i = 0; i < 6; ++i) s.fields[i] = v * (i + 2);
+        return s;
+    }
+};
+
+struct SharedMutexState {
+    Snapshot read() {
+        std::shared_lock<std::shared_mutex> lock(mtx);
+        return data;
+    }
+    void write(std::uint64_t v) {
+        std::unique_lock<std::shared_mutex> lock(mtx);
+        data = Snapshot::of(v);
+    }
+    std::shared_mutex mtx;
+    Snapshot data;
+};
+
+struct SeqLockState {
+    Snapshot read() { return lock.load(); }
+    void write(std::uint64_t v) { lock.store(Snapshot::of(v)); }
+    SeqLock<Snapshot> lock;
+};
+
+template <typename State>
+TimedRun::Result run(int threads, int write_pct, std::chrono::milliseconds duration) {
+    State state;
+    std::atomic<std::uint64_t> next_version{1};
+    TimedRun bench;
+    bench.workers(threads, [&](int t) {
+        std::uint32_t rng = 2463534242u + t;  // xorshift: cheap, per thread
+        return [&, rng]() mutable {
+            rng ^= rng << 13;
+            rng ^= rng >> 17;
+            rng ^= rng << 5;
+            if (static_cast<int>(rng % 100) < write_pct) {
+                state.write(next_version.fetch_add(1));
+                return true;
+            }
+            return state.read().consistent();
+        };
+    });
+    return bench.finish(duration);
+}
+
+// ./seqlockV0 [max_threads] [ms_per_run]
+int main(int argc, char** argv) {
+    int max_threads = argc > 1 ? std::atoi(argv[1]) : 16;
+    std::chrono::milliseconds duration(argc > 2 ? std::atoi(argv[2]) : 200);
+
+    std::cout << "threads\twrite%\tshared_mutex\tseqlock   (M ops/s)\n";
+    for (int write_pct : {0, 1, 10, 50})
+        doubling(max_threads, [&](int threads) {
+            auto sm = run<SharedMutexState>(threads, write_pct, duration);
+            auto sl = run<SeqLockState>(threads, write_pct, duration);
+            std::cout << threads << "\t" << write_pct << "\t" << sm.ops_per_sec / 1e6 << "\t"
+                      << sl.ops_per_sec / 1e6 << (sm.ok && sl.ok ? "" : "\tTORN READ") << "\n";
+        });
+    return 0;
+}
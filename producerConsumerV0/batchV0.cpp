@@ -0,0 +1,95 @@
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <atomic>
+#include <cstdlib>
+
+#include "mpmcQueue.h"
+#include "mutexQueue.h"
+#include "spscRingBuffer.h"
+
+// Batched push/pop benchmark.
+//
+// Producers generate work in bursts of `batch` items and hand each burst over
+// with push_bulk; consumers drain with pop_bulk(out, batch). Reported per
+// batch size: items/s, notifications/s (condition-variable notify calls for
+// MutexQueue, Parker::notify calls for the lock-free queues; one per
+// successful bulk call on either side) and, for the Parker-based queues,
+// futex wakes/s (the notifications that found a parked waiter).
+
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+    double items_per_sec;
+    double notifies_per_sec;
+    double wakes_per_sec;  // < 0: not measured
+};
+
+template <typename Queue>
+Result bench(Queue& q, int producers_n, int consumers_n, long items_per_producer, std::size_t batch) {
+    std::atomic<long long> sum{0};
+    std::vector<std::thread> producers, consumers;
+
+    auto start = Clock::now();
+    for (int p = 0; p < producers_n; ++p) {
+        producers.emplace_back([&] {
+            std::vector<int> burst(batch);
+            for (long i = 1; i <= items_per_producer;) {
+                std::size_t n = 0;
+                while (n < batch && i <= items_per_producer) burst[n++] = static_cast<int>(i++);
+                q.push_bulk(std::span<const int>(burst.data(), n));
+            }
+        });
+    }
+    for (int c = 0; c < consumers_n; ++c) {
+        consumers.emplace_back([&] {
+            std::vector<int> out(batch);
+            long long local = 0;
+            while (std::size_t n = q.pop_bulk(out.data(), batch))
+                for (std::size_t i = 0; i < n; ++i) local += out[i];
+            sum += local;
+        });
+    }
+    for (auto& t : producers) t.join();
+    q.close();
+    for (auto& t : consumers) t.join();
+    std::chrono::duration<double> secs = Clock::now() - start;
+
+    long long expected = producers_n * (items_per_producer * (items_per_producer + 1) / 2);
+    if (sum != expected) std::cerr << "checksum mismatch\n";
+    double wakes = -1;
+    if constexpr (requires { q.wakes(); }) wakes = q.wakes() / secs.count();
+    return {producers_n * items_per_producer / secs.count(), q.notifies() / secs.count(), wakes};
+}
+
+void print_row(const char* name, std::size_t batch, Result r) {
+    std::cout << name << "\t" << batch << "\t" << r.items_per_sec / 1e6 << "\t" << r.notifies_per_sec / 1e6 << "\t";
+    if (r.wakes_per_sec < 0) std::cout << "-\n";
+    else std::cout << r.wakes_per_sec / 1e6 << "\n";
+}
+
+// ./batchV0 [threads_per_side] [items_per_producer] [capacity]
+int main(int argc, char** argv) {
+    int k = argc > 1 ? std::atoi(argv[1]) : 2;
+    long items = argc > 2 ? std::atol(argv[2]) : 1000000;
+    std::size_t capacity = argc > 3 ? std::atol(argv[3]) : 1024;
+
+    std::cout << k << " producers x " << k << " consumers, capacity " << capacity
+              << ", " << items << " items per producer\n";
+    std::cout << "queue\tbatch\tM items/s\tM notifies/s\tM futex wakes/s\n";
+    for (std::size_t batch = 1; batch <= 256; batch *= 2) {
+        MutexQueue<int> mq(capacity);
+        print_row("mutex+cv", batch, bench(mq, k, k, items, batch));
+    }
+    for (std::size_t batch = 1; batch <= 256; batch *= 2) {
+        MpmcQueue<int> lq(capacity);
+        print_row("mpmc", batch, bench(lq, k, k, items, batch));
+    }
+    for (std::size_t batch = 1; batch <= 256; batch *= 2) {
+        auto* sq = new SpscRingBuffer<int, 1024>();
+        print_row("spsc(1x1)", batch, bench(*sq, 1, 1, items, batch));
+        delete sq;
+    }
+    return 0;
+}
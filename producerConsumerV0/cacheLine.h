@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+// std::hardware_destructive_interference_size is not available on every
+// toolchain we build with, so the line size is fixed here. 64 bytes is right
+// for x86 and most ARM cores (Apple M-series uses 128, padding still helps).
+constexpr std::size_t kCacheLineSize = 64;
+
+// CPU hint for spin loops: lets the sibling hyperthread run and avoids the
+// memory-order mis-speculation penalty when the spin finally exits.
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#else
+    std::this_thread::yield();
+#endif
+}
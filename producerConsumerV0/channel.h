@@ -0,0 +1,269 @@
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "threadPool.h"
+
+// C++20 coroutine channel: producers and consumers as coroutines instead of
+// one blocked OS thread each.
+//
+//   Actor producer(Channel<int>& ch) {
+//       for (int i = 0;; ++i) {
+//           const bool sent = co_await ch.send(i);   // false once closed
+//           if (!sent) co_return;
+//       }
+//   }
+//   Actor consumer(Channel<int>& ch) {
+//       for (;;) {
+//           auto item = co_await ch.recv();          // nullopt once closed and drained
+//           if (!item) co_return;
+//           use(*item);
+//       }
+//   }
+//
+// Keep co_await out of while/if conditions: GCC 12 places that awaiter on the
+// resumer's stack, not in the frame, and the channel would link it into a
+// waiter list.
+//
+// A full send / empty recv suspends the coroutine and parks it in the
+// channel; the peer that makes progress possible hands it to the executor.
+// Nothing ever blocks a thread, so thousands of actors share a few threads.
+
+// Where resumed coroutines run.
+class Executor {
+public:
+    virtual ~Executor() = default;
+    virtual void schedule(std::coroutine_handle<> h) = 0;
+};
+
+// Runs everything on the thread that calls run(). Not thread-safe: only
+// schedule from that thread (or before run()).
+class SingleThreadExecutor final : public Executor {
+public:
+    void schedule(std::coroutine_handle<> h) override { ready_.push_back(h); }
+
+    // Resumes coroutines until none are runnable.
+    void run() {
+        while (!ready_.empty()) {
+            auto h = ready_.front();
+            ready_.pop_front();
+            h.resume();
+        }
+    }
+
+private:
+    std::deque<std::coroutine_handle<>> ready_;
+};
+
+// Resumes coroutines on a work-stealing ThreadPool.
+class PoolExecutor final : public Executor {
+public:
+    explicit PoolExecutor(ThreadPool& pool) : pool_(pool) {}
+    void schedule(std::coroutine_handle<> h) override {
+        pool_.post([h] { h.resume(); });
+    }
+
+private:
+    ThreadPool& pool_;
+};
+
+// Fire-and-forget coroutine. Starts suspended; spawn() hands it to an
+// executor. The frame frees itself when the body finishes.
+class Actor {
+public:
+    struct promise_type {
+        Actor get_return_object() { return Actor(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+
+        // Frame accounting, for measuring the per-actor footprint.
+        static void* operator new(std::size_t n) {
+            live_bytes.fetch_add(n, std::memory_order_relaxed);
+            return ::operator new(n);
+        }
+        static void operator delete(void* p, std::size_t n) {
+            live_bytes.fetch_sub(n, std::memory_order_relaxed);
+            ::operator delete(p);
+        }
+        static inline std::atomic<std::size_t> live_bytes{0};
+    };
+
+    Actor(Actor&& other) noexcept : h_(std::exchange(other.h_, {})) {}
+    Actor(const Actor&) = delete;
+    ~Actor() {
+        if (h_) h_.destroy();  // never spawned
+    }
+
+    friend void spawn(Executor& ex, Actor actor) { ex.schedule(std::exchange(actor.h_, {})); }
+
+private:
+    explicit Actor(std::coroutine_handle<promise_type> h) : h_(h) {}
+    std::coroutine_handle<promise_type> h_;
+};
+
+// Bounded multi-producer / multi-consumer channel. capacity == 0 is a
+// rendezvous channel: every send waits for a matching recv.
+//
+// A mutex guards the buffer and the two intrusive waiter lists. It is only
+// held for a few pointer operations and never across a suspension, so with
+// the single-threaded executor it is always uncontended.
+template <typename T>
+class Channel {
+public:
+    Channel(Executor& ex, std::size_t capacity) : ex_(ex), capacity_(capacity) {}
+    Channel(const Channel&) = delete;
+    Channel& operator=(const Channel&) = delete;
+
+    class SendAwaiter {
+    public:
+        bool await_ready() const noexcept { return false; }
+
+        // Returns false (do not suspend) when the send completes right away.
+        // A peer it wakes is only scheduled after mtx_ is released (see
+        // close()), and nothing touches ch_ after that.
+        bool await_suspend(std::coroutine_handle<> h) {
+            handle_ = h;
+            Executor& ex = ch_.ex_;
+            std::coroutine_handle<> wake;
+            {
+                std::lock_guard<std::mutex> lock(ch_.mtx_);
+                if (ch_.closed_) return false;
+                if (RecvAwaiter* r = ch_.receivers_.pop()) {
+                    r->value_.emplace(std::move(value_));
+                    wake = r->handle_;
+                } else if (ch_.buffer_.size() < ch_.capacity_) {
+                    ch_.buffer_.push_back(std::move(value_));
+                } else {
+                    ch_.senders_.push(this);
+                    // Only the guard's unlock follows. A waker needs mtx_
+                    // first, so `this` may be resumed (on another thread)
+                    // only after that; do not touch it or ch_ here.
+                    return true;
+                }
+                ok_ = true;
+            }
+            if (wake) ex.schedule(wake);
+            return false;
+        }
+
+        // False if the channel was closed before the value was taken.
+        bool await_resume() const noexcept { return ok_; }
+
+    private:
+        friend class Channel;
+        SendAwaiter(Channel& ch, T value) : ch_(ch), value_(std::move(value)) {}
+
+        Channel& ch_;
+        T value_;
+        std::coroutine_handle<> handle_;
+        bool ok_ = false;
+        SendAwaiter* next_ = nullptr;
+    };
+
+    class RecvAwaiter {
+    public:
+        bool await_ready() const noexcept { return false; }
+
+        // As SendAwaiter::await_suspend: wakes a peer only after unlocking.
+        bool await_suspend(std::coroutine_handle<> h) {
+            handle_ = h;
+            Executor& ex = ch_.ex_;
+            std::coroutine_handle<> wake;
+            {
+                std::lock_guard<std::mutex> lock(ch_.mtx_);
+                if (!ch_.buffer_.empty()) {
+                    value_.emplace(std::move(ch_.buffer_.front()));
+                    ch_.buffer_.pop_front();
+                    // A slot opened up: admit one waiting sender.
+                    if (SendAwaiter* s = ch_.senders_.pop()) {
+                        ch_.buffer_.push_back(std::move(s->value_));
+                        s->ok_ = true;
+                        wake = s->handle_;
+                    }
+                } else if (SendAwaiter* s = ch_.senders_.pop()) {  // rendezvous handoff
+                    value_.emplace(std::move(s->value_));
+                    s->ok_ = true;
+                    wake = s->handle_;
+                } else if (!ch_.closed_) {
+                    ch_.receivers_.push(this);
+                    return true;  // as in SendAwaiter: only the unlock follows
+                }
+            }
+            if (wake) ex.schedule(wake);
+            return false;
+        }
+
+        // nullopt once the channel is closed and drained.
+        std::optional<T> await_resume() { return std::move(value_); }
+
+    private:
+        friend class Channel;
+        explicit RecvAwaiter(Channel& ch) : ch_(ch) {}
+
+        Channel& ch_;
+        std::optional<T> value_;
+        std::coroutine_handle<> handle_;
+        RecvAwaiter* next_ = nullptr;
+    };
+
+    SendAwaiter send(T value) { return SendAwaiter(*this, std::move(value)); }
+    RecvAwaiter recv() { return RecvAwaiter(*this); }
+
+    // Wakes every waiter: senders get false, receivers drain the buffer and
+    // then get nullopt. The waiters are only scheduled after mtx_ is
+    // released: on a pool they may finish and destroy the channel before
+    // close() returns, so nothing here touches *this after the first one.
+    void close() {
+        std::vector<std::coroutine_handle<>> woken;
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            closed_ = true;
+            while (SendAwaiter* s = senders_.pop()) woken.push_back(s->handle_);
+            while (RecvAwaiter* r = receivers_.pop()) woken.push_back(r->handle_);
+        }
+        Executor& ex = ex_;
+        for (auto h : woken) ex.schedule(h);
+    }
+
+private:
+    // FIFO of suspended awaiters, linked through their `next_` field (the
+    // awaiter lives in the suspended coroutine frame, so no allocation).
+    template <typename W>
+    struct WaitList {
+        W* head = nullptr;
+        W* tail = nullptr;
+        void push(W* w) {
+            w->next_ = nullptr;
+            if (tail) tail->next_ = w;
+            else head = w;
+            tail = w;
+        }
+        W* pop() {
+            W* w = head;
+            if (w) {
+                head = w->next_;
+                if (!head) tail = nullptr;
+            }
+            return w;
+        }
+    };
+
+    Executor& ex_;
+    const std::size_t capacity_;
+    std::mutex mtx_;
+    std::deque<T> buffer_;
+    WaitList<SendAwaiter> senders_;
+    WaitList<RecvAwaiter> receivers_;
+    bool closed_ = false;
+};
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "cacheLine.h"
+
+// Chase-Lev work-stealing deque (memory orders from Le, Pop, Cohen and
+// Zappa Nardelli, "Correct and Efficient Work-Stealing for Weak Memory
+// Models", PPoPP 2013).
+//
+// The owning thread pushes and pops at the bottom like a stack (LIFO keeps
+// recently spawned work hot in its cache); any other thread steals from the
+// top (FIFO, so thieves take the oldest and usually largest piece of work).
+// Only the last element ever needs a CAS between owner and thieves.
+//
+// T must be trivially copyable (in practice a pointer). The buffer grows on
+// demand; old buffers are kept until the deque is destroyed because a thief
+// may still be reading from one.
+template <typename T>
+class ChaseLevDeque {
+    static_assert(std::is_trivially_copyable<T>::value, "ChaseLevDeque holds trivially copyable values");
+
+public:
+    explicit ChaseLevDeque(std::size_t initial_capacity = 256) {
+        std::size_t cap = 1;
+        while (cap < initial_capacity) cap <<= 1;
+        buffers_.emplace_back(new Buffer(cap));
+        buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+    }
+    ChaseLevDeque(const ChaseLevDeque&) = delete;
+    ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+
+    // Owner only.
+    void push(T value) {
+        const std::int64_t b = bottom_.load(std::memory_order_relaxed);
+        const std::int64_t t = top_.load(std::memory_order_acquire);
+        Buffer* buf = buffer_.load(std::memory_order_relaxed);
+        if (b - t > static_cast<std::int64_t>(buf->capacity) - 1) buf = grow(buf, b, t);
+        buf->put(b, value);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+
+    // Owner only. Returns false if the deque is empty.
+    bool pop(T& out) {
+        const std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        Buffer* buf = buffer_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = top_.load(std::memory_order_relaxed);
+        if (t > b) {
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+        out = buf->get(b);
+        if (t == b) {
+            // Last element: race the thieves for it.
+            const bool won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                          std::memory_order_relaxed);
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    // Any thread. Returns false if the deque is empty or the steal lost a race.
+    bool steal(T& out) {
+        std::int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const std::int64_t b = bottom_.load(std::memory_order_acquire);
+        if (t >= b) return false;
+        Buffer* buf = buffer_.load(std::memory_order_acquire);
+        T value = buf->get(t);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return false;
+        out = value;
+        return true;
+    }
+
+    // Approximate when called concurrently.
+    bool empty() const {
+        return bottom_.load(std::memory_order_relaxed) <= top_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Buffer {
+        explicit Buffer(std::size_t cap) : capacity(cap), slots(new std::atomic<T>[cap]) {}
+        T get(std::int64_t i) const { return slots[i & (capacity - 1)].load(std::memory_order_relaxed); }
+        void put(std::int64_t i, T v) { slots[i & (capacity - 1)].store(v, std::memory_order_relaxed); }
+
+        const std::size_t capacity;
+        std::unique_ptr<std::atomic<T>[]> slots;
+    };
+
+    Buffer* grow(Buffer* old, std::int64_t b, std::int64_t t) {
+        buffers_.emplace_back(new Buffer(old->capacity * 2));
+        Buffer* bigger = buffers_.back().get();
+        for (std::int64_t i = t; i < b; ++i) bigger->put(i, old->get(i));
+        buffer_.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+
+    alignas(kCacheLineSize) std::atomic<std::int64_t> top_{0};     // thieves
+    alignas(kCacheLineSize) std::atomic<std::int64_t> bottom_{0};  // owner
+    std::atomic<Buffer*> buffer_;
+    std::vector<std::unique_ptr<Buffer>> buffers_;  // owner only; keeps retired buffers alive
+};
@@ -0,0 +1,189 @@
+#include <iostream>
+#include <fstream>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <atomic>
+#include <algorithm>
+#include <cstdlib>
+#include <unistd.h>
+
+#include "channel.h"
+#include "mutexQueue.h"
+
+// Every co_await below is a statement of its own, never part of a while/if
+// condition: GCC 12 keeps the awaiter of a co_await in a condition on the
+// resumer's stack instead of the coroutine frame, so the channel's waiter
+// list ends up pointing into a reused stack slot.
+//
+// Coroutine actors vs thread-per-actor (the v0.cpp model):
+//   1. switch cost: ping-pong one value between two actors
+//   2. footprint:   memory per idle actor waiting on an empty channel
+//   3. throughput:  thousands of producers/consumers on one channel
+
+using Clock = std::chrono::steady_clock;
+
+// Resident set size in bytes (Linux); 0 where /proc is not available.
+long rss_bytes() {
+    std::ifstream statm("/proc/self/statm");
+    long pages_total = 0, pages_resident = 0;
+    if (!(statm >> pages_total >> pages_resident)) return 0;
+    return pages_resident * sysconf(_SC_PAGESIZE);
+}
+
+// ---------------------------------------------------------------------------
+// 1. Switch cost
+// ---------------------------------------------------------------------------
+Actor pinger(Channel<int>& out, Channel<int>& in, int rounds) {
+    for (int i = 0; i < rounds; ++i) {
+        co_await out.send(i);
+        co_await in.recv();
+    }
+    out.close();
+}
+
+Actor ponger(Channel<int>& in, Channel<int>& out) {
+    for (;;) {
+        auto v = co_await in.recv();
+        if (!v) break;
+        co_await out.send(*v);
+    }
+}
+
+double coroutine_switch_ns(int rounds) {
+    SingleThreadExecutor ex;
+    Channel<int> ping(ex, 0), pong(ex, 0);
+    spawn(ex, pinger(ping, pong, rounds));
+    spawn(ex, ponger(ping, pong));
+    auto start = Clock::now();
+    ex.run();
+    std::chrono::duration<double, std::nano> ns = Clock::now() - start;
+    return ns.count() / (2.0 * rounds);  // two switches per round trip
+}
+
+double thread_switch_ns(int rounds) {
+    MutexQueue<int> ping(1), pong(1);
+    auto start = Clock::now();
+    std::thread t([&] {
+        int v;
+        while (ping.pop(v)) pong.push(v);
+    });
+    int v;
+    for (int i = 0; i < rounds; ++i) {
+        ping.push(i);
+        pong.pop(v);
+    }
+    ping.close();
+    t.join();
+    std::chrono::duration<double, std::nano> ns = Clock::now() - start;
+    return ns.count() / (2.0 * rounds);
+}
+
+// ---------------------------------------------------------------------------
+// 2. Footprint of an idle actor
+// ---------------------------------------------------------------------------
+Actor idle_consumer(Channel<int>& ch) {
+    for (;;) {
+        auto v = co_await ch.recv();
+        if (!v) break;
+    }
+}
+
+void coroutine_footprint(int actors) {
+    SingleThreadExecutor ex;
+    Channel<int> ch(ex, 0);
+    long rss_before = rss_bytes();
+    std::size_t frames_before = Actor::promise_type::live_bytes;
+    for (int i = 0; i < actors; ++i) spawn(ex, idle_consumer(ch));
+    ex.run();  // everyone is now suspended in recv()
+    long rss_after = rss_bytes();
+    std::size_t frames = Actor::promise_type::live_bytes - frames_before;
+    std::cout << "coroutine: " << actors << " idle actors, frame " << frames / actors << " B/actor, rss +"
+              << (rss_after - rss_before) / actors << " B/actor\n";
+    ch.close();
+    ex.run();
+}
+
+void thread_footprint(int actors) {
+    MutexQueue<int> q(1);
+    long rss_before = rss_bytes();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < actors; ++i)
+        threads.emplace_back([&] {
+            int v;
+            while (q.pop(v)) {
+            }
+        });
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));  // let them all block
+    long rss_after = rss_bytes();
+    std::cout << "thread:    " << actors << " idle actors, rss +" << (rss_after - rss_before) / actors
+              << " B/actor (plus a reserved stack, 8 MB by default on Linux)\n";
+    q.close();
+    for (auto& t : threads) t.join();
+}
+
+// ---------------------------------------------------------------------------
+// 3. Many actors on one channel
+// ---------------------------------------------------------------------------
+Actor producer(Channel<long>& ch, long items, std::atomic<int>& producers_left) {
+    for (long i = 1; i <= items; ++i) {
+        const bool sent = co_await ch.send(i);
+        if (!sent) break;
+    }
+    if (producers_left.fetch_sub(1) == 1) ch.close();
+}
+
+Actor consumer(Channel<long>& ch, std::atomic<long long>& sum, std::atomic<int>& consumers_left) {
+    long long local = 0;
+    for (;;) {
+        auto v = co_await ch.recv();
+        if (!v) break;
+        local += *v;
+    }
+    sum += local;
+    consumers_left.fetch_sub(1);
+}
+
+template <typename Run>
+void many_actors(const char* name, Executor& ex, Run run, int producers_n, int consumers_n, long items) {
+    Channel<long> ch(ex, 64);
+    std::atomic<long long> sum{0};
+    std::atomic<int> producers_left{producers_n}, consumers_left{consumers_n};
+    auto start = Clock::now();
+    for (int c = 0; c < consumers_n; ++c) spawn(ex, consumer(ch, sum, consumers_left));
+    for (int p = 0; p < producers_n; ++p) spawn(ex, producer(ch, items, producers_left));
+    run(consumers_left);
+    std::chrono::duration<double> secs = Clock::now() - start;
+    long long expected = producers_n * (items * (items + 1) / 2);
+    std::cout << name << ": " << producers_n << " producers x " << consumers_n << " consumers, "
+              << producers_n * items / secs.count() / 1e6 << " M items/s"
+              << (sum == expected ? "" : "  CHECKSUM MISMATCH") << "\n";
+}
+
+// ./coroChannelV0 [actors] [rounds]
+int main(int argc, char** argv) {
+    int actors = argc > 1 ? std::atoi(argv[1]) : 1000;
+    int rounds = argc > 2 ? std::atoi(argv[2]) : 200000;
+
+    std::cout << "switch cost, coroutine (1 thread): " << coroutine_switch_ns(rounds) << " ns\n";
+    std::cout << "switch cost, thread + mutex/cv:     " << thread_switch_ns(rounds / 10) << " ns\n";
+
+    coroutine_footprint(actors * 10);
+    thread_footprint(actors);
+
+    {
+        SingleThreadExecutor ex;
+        many_actors("single-thread executor", ex, [&](std::atomic<int>&) { ex.run(); }, actors, actors, 100);
+    }
+    {
+        ThreadPool pool;
+        PoolExecutor ex(pool);
+        std::cout << "pool threads: " << pool.size() << "\n";
+        many_actors("pool executor", ex,
+                    [](std::atomic<int>& left) {
+                        while (left.load() != 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    },
+                    actors, actors, 100);
+    }
+    return 0;
+}
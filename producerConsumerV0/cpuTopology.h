@@ -0,0 +1,287 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// CPU / cache topology from sysfs and thread placement on top of it.
+//
+// v0.cpp starts its threads with plain emplace_back, so on a two-socket box
+// a producer and the consumer it feeds can land on different sockets and
+// every queue cache line crosses the interconnect. Here each logical CPU is
+// described by the domains it belongs to:
+//
+//   /sys/devices/system/cpu/cpuN/topology/{physical_package_id,core_id}
+//   /sys/devices/system/cpu/cpuN/cache/indexK/{level,type,shared_cpu_list}
+//   /sys/devices/system/node/nodeM/cpulist
+//
+// and a placement policy turns "P producers, C consumers" into one CPU per
+// thread:
+//   none     do not pin (scheduler's choice)
+//   pair     producer i and consumer i share an L2 (SMT siblings) if the
+//            machine has them, else an L3; each pair gets its own domain
+//            while there are enough
+//   compact  fill CPUs in topology order: one socket, one L3 first
+//   spread   round-robin over sockets, then cores, SMT siblings last
+//
+//   CpuTopology topo = CpuTopology::detect();
+//   std::vector<int> cpus = plan_placement(topo, Placement::pair, P, C);
+//   // thread t (producers 0..P-1, then consumers P..P+C-1):
+//   pin_this_thread(cpus[t]);
+//
+// Only CPUs in the process's affinity mask are used. Without sysfs (or off
+// Linux) every CPU is its own core in one package, so the policies still
+// run but pin nothing useful.
+
+enum class Placement { none, pair, compact, spread };
+
+inline bool parse_placement(const std::string& s, Placement& out) {
+    if (s == "none") out = Placement::none;
+    else if (s == "pair") out = Placement::pair;
+    else if (s == "compact") out = Placement::compact;
+    else if (s == "spread") out = Placement::spread;
+    else return false;
+    return true;
+}
+
+inline const char* placement_name(Placement p) {
+    switch (p) {
+        case Placement::none: return "none";
+        case Placement::pair: return "pair";
+        case Placement::compact: return "compact";
+        case Placement::spread: return "spread";
+    }
+    return "?";
+}
+
+struct CpuInfo {
+    int cpu = 0;
+    int package = 0;
+    int node = 0;
+    int core = 0;  // core_id is only unique within a package
+    int l2 = 0;    // lowest CPU sharing this CPU's L2: a domain id
+    int l3 = 0;    // same for the L3
+};
+
+class CpuTopology {
+public:
+    static CpuTopology detect() {
+        CpuTopology t;
+        std::map<int, int> node_of;  // empty on non-NUMA kernels: everything is node 0
+        std::string online;
+        if (read_line("/sys/devices/system/node/online", online))
+            for (int node : parse_cpu_list(online)) {
+                std::string list;
+                if (read_line("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist", list))
+                    for (int cpu : parse_cpu_list(list)) node_of[cpu] = node;
+            }
+
+        for (int cpu : allowed_cpus()) {
+            const std::string dir = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+            CpuInfo c;
+            c.cpu = cpu;
+            c.package = read_int(dir + "/topology/physical_package_id", 0);
+            c.core = read_int(dir + "/topology/core_id", cpu);
+            c.node = node_of.count(cpu) ? node_of[cpu] : 0;
+            c.l2 = -1;
+            c.l3 = -1;
+            for (int index = 0;; ++index) {
+                const std::string cache = dir + "/cache/index" + std::to_string(index);
+                std::string type, list;
+                if (!read_line(cache + "/type", type)) break;
+                if (type == "Instruction" || !read_line(cache + "/shared_cpu_list", list)) continue;
+                std::vector<int> sharing = parse_cpu_list(list);
+                if (sharing.empty()) continue;
+                const int level = read_int(cache + "/level", 0);
+                if (level == 2) c.l2 = sharing.front();
+                else if (level == 3) c.l3 = sharing.front();
+            }
+            // Missing levels: an L2 per core, an L3 per package.
+            if (c.l2 < 0) c.l2 = cpu;
+            if (c.l3 < 0) c.l3 = -1 - c.package;
+            t.cpus_.push_back(c);
+        }
+        return t;
+    }
+
+    const std::vector<CpuInfo>& cpus() const { return cpus_; }
+
+    // e.g. "8 cpus, 2 packages, 2 nodes, 4 L3, 8 L2"
+    std::string summary() const {
+        std::set<int> packages, nodes, l3, l2;
+        for (const auto& c : cpus_) {
+            packages.insert(c.package);
+            nodes.insert(c.node);
+            l3.insert(c.l3);
+            l2.insert(c.l2);
+        }
+        std::ostringstream os;
+        os << cpus_.size() << " cpus, " << packages.size() << " packages, " << nodes.size() << " nodes, "
+           << l3.size() << " L3, " << l2.size() << " L2";
+        return os.str();
+    }
+
+    // "0-3,8,10-11" -> {0,1,2,3,8,10,11}
+    static std::vector<int> parse_cpu_list(const std::string& s) {
+        std::vector<int> out;
+        std::stringstream ss(s);
+        std::string part;
+        while (std::getline(ss, part, ',')) {
+            if (part.empty()) continue;
+            const auto dash = part.find('-');
+            const int lo = std::atoi(part.c_str());
+            const int hi = dash == std::string::npos ? lo : std::atoi(part.c_str() + dash + 1);
+            for (int cpu = lo; cpu <= hi; ++cpu) out.push_back(cpu);
+        }
+        return out;
+    }
+
+private:
+    static bool read_line(const std::string& path, std::string& out) {
+        std::ifstream in(path);
+        return static_cast<bool>(std::getline(in, out));
+    }
+
+    static int read_int(const std::string& path, int fallback) {
+        std::string s;
+        return read_line(path, s) && !s.empty() ? std::atoi(s.c_str()) : fallback;
+    }
+
+    static std::vector<int> allowed_cpus() {
+        std::vector<int> out;
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+                if (CPU_ISSET(cpu, &set)) out.push_back(cpu);
+            return out;
+        }
+#endif
+        const int n = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        for (int cpu = 0; cpu < n; ++cpu) out.push_back(cpu);
+        return out;
+    }
+
+    std::vector<CpuInfo> cpus_;
+};
+
+namespace detail {
+
+// Topology order: package, L3, L2, core, CPU. Neighbours share the most.
+inline std::vector<CpuInfo> compact_order(const CpuTopology& topo) {
+    std::vector<CpuInfo> v = topo.cpus();
+    std::sort(v.begin(), v.end(), [](const CpuInfo& a, const CpuInfo& b) {
+        return std::tie(a.package, a.l3, a.l2, a.core, a.cpu) < std::tie(b.package, b.l3, b.l2, b.core, b.cpu);
+    });
+    return v;
+}
+
+// Neighbours share the least. Each CPU is ranked by (SMT sibling index in
+// its core, core index in its L3, L3 index in its package, package), so the
+// order visits every package, then every L3, then every core before it
+// reuses a core's second hardware thread.
+inline std::vector<CpuInfo> spread_order(const CpuTopology& topo) {
+    std::map<std::pair<int, int>, int> sibling;     // (package, core) -> threads seen
+    std::map<std::pair<int, int>, int> core_in_l3;  // (l3, sibling) -> cores seen
+    std::map<int, std::map<int, int>> l3_in_pkg;    // package -> l3 -> index
+    std::vector<std::pair<std::tuple<int, int, int, int>, CpuInfo>> ranked;
+    for (const CpuInfo& c : compact_order(topo)) {
+        auto& l3s = l3_in_pkg[c.package];
+        const int l3_index = l3s.emplace(c.l3, static_cast<int>(l3s.size())).first->second;
+        const int s = sibling[{c.package, c.core}]++;
+        ranked.push_back({{s, core_in_l3[{c.l3, s}]++, l3_index, c.package}, c});
+    }
+    std::stable_sort(ranked.begin(), ranked.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+    std::vector<CpuInfo> v;
+    for (auto& r : ranked) v.push_back(r.second);
+    return v;
+}
+
+}  // namespace detail
+
+// One CPU per thread: producers 0..P-1 then consumers P..P+C-1. -1 means
+// "do not pin". With more threads than CPUs the plan wraps around.
+inline std::vector<int> plan_placement(const CpuTopology& topo, Placement policy, int producers, int consumers) {
+    const int threads = producers + consumers;
+    std::vector<int> plan(threads, -1);
+    if (policy == Placement::none || topo.cpus().empty()) return plan;
+
+    if (policy == Placement::compact || policy == Placement::spread) {
+        const auto order = policy == Placement::compact ? detail::compact_order(topo) : detail::spread_order(topo);
+        for (int t = 0; t < threads; ++t) plan[t] = order[t % order.size()].cpu;
+        return plan;
+    }
+
+    // pair: cut each sharing domain (L2 if any L2 has two CPUs, else L3)
+    // into two-CPU slots, deal the slots out round-robin over domains so
+    // pairs do not pile into one L3, then place leftovers compactly.
+    const auto order = detail::compact_order(topo);
+    bool smt = false;
+    for (std::size_t i = 1; i < order.size(); ++i) smt |= order[i].l2 == order[i - 1].l2;
+
+    std::vector<std::vector<int>> domains;
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        const bool same = i > 0 && (smt ? order[i].l2 == order[i - 1].l2 : order[i].l3 == order[i - 1].l3);
+        if (!same) domains.emplace_back();
+        domains.back().push_back(order[i].cpu);
+    }
+    std::size_t largest = 0;
+    for (const auto& d : domains) largest = std::max(largest, d.size());
+    std::vector<std::pair<int, int>> slots;  // (producer cpu, consumer cpu)
+    std::vector<int> singles;
+    for (std::size_t i = 0; i < largest; i += 2)
+        for (const auto& d : domains) {
+            if (i + 1 < d.size()) slots.emplace_back(d[i], d[i + 1]);
+            else if (i < d.size()) singles.push_back(d[i]);
+        }
+    if (slots.empty()) {  // a single CPU: everything shares it
+        for (auto& cpu : plan) cpu = order.front().cpu;
+        return plan;
+    }
+
+    const int pairs = std::min(producers, consumers);
+    std::vector<int> rest;
+    for (const auto& s : slots) {
+        rest.push_back(s.first);
+        rest.push_back(s.second);
+    }
+    rest.insert(rest.end(), singles.begin(), singles.end());
+    for (int i = 0; i < pairs; ++i) {
+        const auto& s = slots[i % slots.size()];
+        plan[i] = s.first;
+        plan[producers + i] = s.second;
+    }
+    // Unpaired threads take the CPUs after the paired ones.
+    std::size_t next = 2 * static_cast<std::size_t>(pairs);
+    for (int i = pairs; i < producers; ++i) plan[i] = rest[next++ % rest.size()];
+    for (int i = pairs; i < consumers; ++i) plan[producers + i] = rest[next++ % rest.size()];
+    return plan;
+}
+
+// Pins the calling thread to `cpu` (-1: leave it alone). Returns false if
+// the kernel refused.
+inline bool pin_this_thread(int cpu) {
+    if (cpu < 0) return true;
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
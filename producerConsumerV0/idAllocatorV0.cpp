@@ -0,0 +1,97 @@
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+#include "idAllocator.h"
+
+// ID allocation at high producer counts:
+//   mutex      ++item_id under a std::mutex (what v0.cpp does under mtx)
+//   fetch_add  one atomic increment per ID
+//   block N    IdAllocator, one fetch_add per N IDs
+// Each thread allocates `ids_per_thread` IDs and xors them into a local sink
+// so the loop is not optimized away.
+
+using Clock = std::chrono::steady_clock;
+
+template <typename Body>
+double run(int threads, long ids_per_thread, Body body) {
+    std::vector<std::thread> workers;
+    std::atomic<std::uint64_t> sink{0};
+    auto start = Clock::now();
+    for (int t = 0; t < threads; ++t)
+        workers.emplace_back([&] { sink ^= body(ids_per_thread); });
+    for (auto& w : workers) w.join();
+    std::chrono::duration<double> secs = Clock::now() - start;
+    return threads * ids_per_thread / secs.count();
+}
+
+// Uniqueness and per-producer monotonicity check on a small run.
+bool check(int threads, long ids_per_thread, std::size_t block) {
+    IdAllocator ids(block);
+    std::vector<std::vector<std::uint64_t>> seen(threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t)
+        workers.emplace_back([&, t] {
+            IdAllocator::Local local(ids);
+            for (long i = 0; i < ids_per_thread; ++i) seen[t].push_back(local.next());
+        });
+    for (auto& w : workers) w.join();
+
+    std::vector<std::uint64_t> all;
+    for (auto& s : seen) {
+        if (!std::is_sorted(s.begin(), s.end())) return false;
+        all.insert(all.end(), s.begin(), s.end());
+    }
+    std::sort(all.begin(), all.end());
+    return std::adjacent_find(all.begin(), all.end()) == all.end();
+}
+
+// ./idAllocatorV0 [max_threads] [ids_per_thread]
+int main(int argc, char** argv) {
+    int max_threads = argc > 1 ? std::atoi(argv[1]) : 64;
+    long n = argc > 2 ? std::atol(argv[2]) : 2000000;
+
+    std::cout << "unique + per-producer monotonic: " << (check(8, 100000, 64) ? "ok" : "FAILED") << "\n";
+    std::cout << "threads\tmutex\tfetch_add\tblock 64\tblock 1024   (M ids/s)\n";
+    for (int threads = 1;; threads = std::min(threads * 2, max_threads)) {
+        std::mutex mtx;
+        int item_id = 0;
+        double m = run(threads, n, [&](long k) {
+            std::uint64_t x = 0;
+            for (long i = 0; i < k; ++i) {
+                std::lock_guard<std::mutex> lock(mtx);
+                x ^= ++item_id;
+            }
+            return x;
+        });
+
+        alignas(kCacheLineSize) std::atomic<std::uint64_t> counter{0};
+        double f = run(threads, n, [&](long k) {
+            std::uint64_t x = 0;
+            for (long i = 0; i < k; ++i) x ^= counter.fetch_add(1, std::memory_order_relaxed) + 1;
+            return x;
+        });
+
+        double b[2];
+        std::size_t blocks[2] = {64, 1024};
+        for (int j = 0; j < 2; ++j) {
+            IdAllocator ids(blocks[j]);
+            b[j] = run(threads, n, [&](long k) {
+                IdAllocator::Local local(ids);
+                std::uint64_t x = 0;
+                for (long i = 0; i < k; ++i) x ^= local.next();
+                return x;
+            });
+        }
+        std::cout << threads << "\t" << m / 1e6 << "\t" << f / 1e6 << "\t" << b[0] / 1e6 << "\t" << b[1] / 1e6
+                  << "\n";
+        if (threads >= max_threads) break;
+    }
+    return 0;
+}
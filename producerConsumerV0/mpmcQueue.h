@@ -0,0 +1,299 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <span>
+#include <utility>
+
+#include "cacheLine.h"
+#include "waitStrategy.h"
+
+// Bounded multi-producer / multi-consumer queue (Dmitry Vyukov's design).
+//
+// Every slot carries a sequence number that says whose turn it is:
+//   seq == pos            slot is free for the producer claiming `pos`
+//   seq == pos + 1        slot holds data for the consumer claiming `pos`
+//   seq == pos + capacity slot was consumed and is free for the next lap
+// Producers and consumers each claim a position with one CAS on their own
+// counter and then only touch the claimed slot, so producers never contend
+// with consumers and nobody holds a lock across the copy.
+//
+// Positions grow monotonically and are reduced with `% capacity`, so the
+// capacity does not have to be a power of two (MAX_BUFFER_SIZE = 10 works).
+// It must be at least 2: with one slot the "filled" sequence pos + 1 equals
+// the next lap's "free" sequence pos + capacity, so a second push would
+// overwrite an unconsumed element. Smaller requests are rounded up to 2
+// (capacity() reports the real size).
+//
+// T may be move-only and need not be default-constructible: try_pop() and
+// pop() without arguments return std::optional<T>. The T& overloads assign
+// into an existing object, and the bulk calls copy from the span and so need
+// a copyable T.
+//
+// Blocking calls wait with the spin-then-park strategy in waitStrategy.h;
+// successful operations only make a wake syscall if the other side is parked.
+template <typename T>
+class MpmcQueue {
+public:
+    explicit MpmcQueue(std::size_t capacity, WaitPolicy policy = {})
+        : capacity_(std::max<std::size_t>(capacity, 2)), cells_(new Cell[capacity_]), policy_(policy) {
+        for (std::size_t i = 0; i < capacity_; ++i)
+            cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+    ~MpmcQueue() {
+        // Destroy whatever is still queued (no concurrent users by now).
+        const std::size_t tail = enqueue_pos_.load(std::memory_order_relaxed);
+        for (std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed); pos != tail; ++pos)
+            cells_[pos % capacity_].value()->~T();
+    }
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    // Returns false if the queue is full.
+    bool try_push(const T& value) { return pushed(enqueue(value)); }
+    bool try_push(T&& value) { return pushed(enqueue(std::move(value))); }
+
+    // Returns false if the queue is empty.
+    bool try_pop(T& out) { return popped(dequeue(assign_to(out))); }
+
+    // nullopt if the queue is empty. Needs no default-constructible T.
+    std::optional<T> try_pop() {
+        std::optional<T> out;
+        popped(dequeue(emplace_into(out)));
+        return out;
+    }
+
+    // Waits while full. Returns false if the queue was closed (the value is
+    // then dropped).
+    bool push(T value) {
+        bool ok = false;
+        not_full_.wait_until([&] { return closed() || (ok = enqueue(std::move(value))); }, policy_);
+        return pushed(ok);
+    }
+
+    // Waits while empty. Returns false once closed and drained.
+    bool pop(T& out) {
+        bool ok = false;
+        not_empty_.wait_until([&] { return (ok = dequeue(assign_to(out))) || closed(); }, policy_);
+        if (!ok) ok = dequeue(assign_to(out));  // closed: drain what is left
+        return popped(ok);
+    }
+
+    // As pop(T&), nullopt once closed and drained.
+    std::optional<T> pop() {
+        std::optional<T> out;
+        not_empty_.wait_until([&] { return dequeue(emplace_into(out)) || closed(); }, policy_);
+        if (!out) dequeue(emplace_into(out));
+        popped(out.has_value());
+        return out;
+    }
+
+    // Bulk variants: claim up to N consecutive positions with a single CAS.
+    // Only the run of slots that is ready right now is claimed, so a batch
+    // never waits on a slow peer inside the claimed range.
+
+    // Pushes as many of `items` as fit. Returns how many were pushed.
+    std::size_t try_push_bulk(std::span<const T> items) { return pushed_n(enqueue_bulk(items)); }
+
+    // Pops up to `max` items into `out`. Returns how many were popped.
+    std::size_t try_pop_bulk(T* out, std::size_t max) { return popped_n(dequeue_bulk(out, max)); }
+
+    // Pushes all of `items`, waiting for room as needed. Returns fewer than
+    // items.size() only if the queue was closed.
+    std::size_t push_bulk(std::span<const T> items) {
+        std::size_t done = 0;
+        while (done < items.size()) {
+            std::size_t n = 0;
+            not_full_.wait_until([&] { return closed() || (n = enqueue_bulk(items.subspan(done))) != 0; },
+                                 policy_);
+            if (n == 0) break;  // closed
+            done += pushed_n(n);
+        }
+        return done;
+    }
+
+    // Waits until at least one item is available, then pops up to `max`.
+    // Returns 0 once closed and drained.
+    std::size_t pop_bulk(T* out, std::size_t max) {
+        std::size_t n = 0;
+        not_empty_.wait_until([&] { return (n = dequeue_bulk(out, max)) != 0 || closed(); }, policy_);
+        if (n == 0) n = dequeue_bulk(out, max);
+        return popped_n(n);
+    }
+
+    void close() {
+        closed_.store(true, std::memory_order_release);
+        not_full_.notify_all();
+        not_empty_.notify_all();
+    }
+    bool closed() const { return closed_.load(std::memory_order_acquire); }
+
+    // Approximate when called concurrently.
+    std::size_t size() const {
+        const std::size_t tail = enqueue_pos_.load(std::memory_order_acquire);
+        const std::size_t head = dequeue_pos_.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+    std::size_t capacity() const { return capacity_; }
+
+    // Parker notifications sent so far, and wake syscalls among them.
+    std::uint64_t notifies() const { return not_full_.notifies() + not_empty_.notifies(); }
+    std::uint64_t wakes() const { return not_full_.wakes() + not_empty_.wakes(); }
+
+private:
+    // Raw storage, so T only has to be move-constructible (move-only types
+    // such as std::unique_ptr or slab handles work; no default constructor).
+    struct Cell {
+        std::atomic<std::size_t> seq;
+        alignas(T) unsigned char storage[sizeof(T)];
+        T* value() { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    template <typename U>
+    bool enqueue(U&& value) {
+        std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos % capacity_];
+            const std::size_t seq = cell.seq.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff =
+                static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    ::new (static_cast<void*>(cell.storage)) T(std::forward<U>(value));
+                    cell.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // consumer has not freed this slot yet: full
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    static auto assign_to(T& out) {
+        return [&out](T&& v) { out = std::move(v); };
+    }
+    static auto emplace_into(std::optional<T>& out) {
+        return [&out](T&& v) { out.emplace(std::move(v)); };
+    }
+
+    // Moves the front element into take(T&&).
+    template <typename Take>
+    bool dequeue(Take take) {
+        std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos % capacity_];
+            const std::size_t seq = cell.seq.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff =
+                static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    take(std::move(*cell.value()));
+                    cell.value()->~T();
+                    cell.seq.store(pos + capacity_, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // slot not yet filled: empty
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    std::size_t enqueue_bulk(std::span<const T> items) {
+        if (items.empty()) return 0;
+        std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            const std::size_t n = ready_run(pos, 0, items.size());
+            if (n == 0) {
+                const std::size_t now = enqueue_pos_.load(std::memory_order_relaxed);
+                if (now == pos) return 0;  // full
+                pos = now;
+                continue;
+            }
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed)) {
+                for (std::size_t i = 0; i < n; ++i) {
+                    Cell& cell = cells_[(pos + i) % capacity_];
+                    ::new (static_cast<void*>(cell.storage)) T(items[i]);
+                    cell.seq.store(pos + i + 1, std::memory_order_release);
+                }
+                return n;
+            }
+        }
+    }
+
+    std::size_t dequeue_bulk(T* out, std::size_t max) {
+        if (max == 0) return 0;
+        std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            const std::size_t n = ready_run(pos, 1, max);
+            if (n == 0) {
+                const std::size_t now = dequeue_pos_.load(std::memory_order_relaxed);
+                if (now == pos) return 0;  // empty
+                pos = now;
+                continue;
+            }
+            if (dequeue_pos_.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed)) {
+                for (std::size_t i = 0; i < n; ++i) {
+                    Cell& cell = cells_[(pos + i) % capacity_];
+                    out[i] = std::move(*cell.value());
+                    cell.value()->~T();
+                    cell.seq.store(pos + i + capacity_, std::memory_order_release);
+                }
+                return n;
+            }
+        }
+    }
+
+    // Length of the run of slots starting at `pos` (at most `max`) whose
+    // sequence is `pos + i + lag`, i.e. ready for the caller's side
+    // (lag 0: free for producers, lag 1: filled for consumers). The run is
+    // only trusted after the CAS on the position counter succeeds.
+    std::size_t ready_run(std::size_t pos, std::size_t lag, std::size_t max) const {
+        max = std::min(max, capacity_);
+        std::size_t n = 0;
+        while (n < max &&
+               cells_[(pos + n) % capacity_].seq.load(std::memory_order_acquire) == pos + n + lag)
+            ++n;
+        return n;
+    }
+
+    // Wake the other side only if it is parked (Parker skips the syscall
+    // otherwise). A batch can satisfy several waiters.
+    bool pushed(bool ok) {
+        if (ok) not_empty_.notify_one();
+        return ok;
+    }
+    bool popped(bool ok) {
+        if (ok) not_full_.notify_one();
+        return ok;
+    }
+    std::size_t pushed_n(std::size_t n) {
+        if (n == 1) not_empty_.notify_one();
+        else if (n > 1) not_empty_.notify_all();
+        return n;
+    }
+    std::size_t popped_n(std::size_t n) {
+        if (n == 1) not_full_.notify_one();
+        else if (n > 1) not_full_.notify_all();
+        return n;
+    }
+
+    const std::size_t capacity_;
+    const std::unique_ptr<Cell[]> cells_;
+    const WaitPolicy policy_;
+
+    alignas(kCacheLineSize) std::atomic<std::size_t> enqueue_pos_{0};
+    alignas(kCacheLineSize) std::atomic<std::size_t> dequeue_pos_{0};
+    alignas(kCacheLineSize) std::atomic<bool> closed_{false};
+
+    Parker not_full_;   // producers wait here
+    Parker not_empty_;  // consumers wait here
+};
@@ -0,0 +1,168 @@
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <atomic>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include "mpmcQueue.h"
+#include "mutexQueue.h"
+
+const int MAX_BUFFER_SIZE = 10;
+
+// ---------------------------------------------------------------------------
+// Demo: the 3x3 setup from v0.cpp main() with the lock-free queue.
+// ---------------------------------------------------------------------------
+MpmcQueue<int> buffer(MAX_BUFFER_SIZE);
+std::atomic<int> item_id{0};
+
+void producer(int id) {
+    while (true) {
+        int item = ++item_id;
+        if (!buffer.push(item)) break;  // closed
+        std::cout << "[Producer " << id << "] produced: " << item << "\n";
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    std::cout << "[Producer " << id << "] exiting\n";
+}
+
+void consumer(int id) {
+    int item;
+    while (buffer.pop(item)) {
+        std::cout << "    [Consumer " << id << "] consumed: " << item << "\n";
+        std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    }
+    std::cout << "    [Consumer " << id << "] exiting\n";
+}
+
+void run_demo() {
+    const int num_producers = 3;
+    const int num_consumers = 3;
+
+    std::vector<std::thread> producers, consumers;
+    for (int i = 0; i < num_producers; ++i)
+        producers.emplace_back(producer, i);
+    for (int i = 0; i < num_consumers; ++i)
+        consumers.emplace_back(consumer, i);
+
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+    buffer.close();
+
+    for (auto& p : producers) p.join();
+    for (auto& c : consumers) c.join();
+    std::cout << "All threads exited.\n";
+}
+
+// ---------------------------------------------------------------------------
+// Scaling benchmark: k producers x k consumers, k = 1..max_threads.
+// Each producer pushes items_per_producer items; consumers pop until the
+// queue is closed and drained.
+// ---------------------------------------------------------------------------
+using Clock = std::chrono::steady_clock;
+
+template <typename Queue>
+double bench(Queue& q, int producers_n, int consumers_n, long items_per_producer) {
+    std::atomic<long long> sum{0};
+    std::vector<std::thread> producers, consumers;
+
+    auto start = Clock::now();
+    for (int p = 0; p < producers_n; ++p) {
+        producers.emplace_back([&] {
+            for (long i = 1; i <= items_per_producer; ++i) q.push(static_cast<int>(i));
+        });
+    }
+    for (int c = 0; c < consumers_n; ++c) {
+        consumers.emplace_back([&] {
+            long long local = 0;
+            int item;
+            while (q.pop(item)) local += item;
+            sum += local;
+        });
+    }
+    for (auto& t : producers) t.join();
+    q.close();
+    for (auto& t : consumers) t.join();
+    std::chrono::duration<double> secs = Clock::now() - start;
+
+    long long expected = producers_n * (items_per_producer * (items_per_producer + 1) / 2);
+    if (sum != expected) std::cerr << "checksum mismatch\n";
+    return producers_n * items_per_producer / secs.count();
+}
+
+void run_bench(int max_threads, long items_per_producer, std::size_t capacity) {
+    std::cout << "capacity " << capacity << ", " << items_per_producer << " items per producer\n";
+    std::cout << "P x C    mutex+cv (M/s)    mpmc (M/s)\n";
+    // 1, 2, 4, ... and always max_threads itself.
+    for (int k = 1;; k = std::min(k * 2, max_threads)) {
+        MutexQueue<int> mq(capacity);
+        MpmcQueue<int> lq(capacity);
+        double m = bench(mq, k, k, items_per_producer);
+        double l = bench(lq, k, k, items_per_producer);
+        std::cout << k << " x " << k << "    " << m / 1e6 << "    " << l / 1e6 << "\n";
+        if (k >= max_threads) break;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Edge cases: capacity 0 and 1 are rounded up to 2, which is the smallest
+// size whose "filled" and "free next lap" sequence numbers differ.
+// ---------------------------------------------------------------------------
+bool run_check() {
+    bool ok = true;
+    auto expect = [&](bool cond, const char* what) {
+        if (!cond) std::cerr << "FAILED: " << what << "\n";
+        ok &= cond;
+    };
+    for (std::size_t requested : {0, 1}) {
+        MpmcQueue<int> q(requested);
+        expect(q.capacity() == 2, "capacity rounded up to 2");
+        int out = 0;
+        expect(q.try_push(1), "first push");
+        expect(q.try_push(2), "second push");
+        expect(!q.try_push(3), "third push reports full");
+        expect(q.try_pop(out) && out == 1, "pop returns first element");
+        expect(q.try_pop(out) && out == 2, "pop returns second element");
+        expect(!q.try_pop(out), "pop reports empty");
+    }
+    {
+        // No default constructor: only the optional-returning pops work.
+        struct Id {
+            explicit Id(int v) : v(v) {}
+            int v;
+        };
+        MpmcQueue<Id> q(4);
+        expect(q.try_push(Id(7)) && q.push(Id(8)), "push without default constructor");
+        auto a = q.try_pop();
+        expect(a && a->v == 7, "try_pop() returns first element");
+        q.close();
+        auto b = q.pop();
+        expect(b && b->v == 8, "pop() drains after close");
+        expect(!q.try_pop() && !q.pop(), "empty and closed: nullopt");
+    }
+    std::cout << (ok ? "check: ok\n" : "check: FAILED\n");
+    return ok;
+}
+
+// ./mpmcV0                                 run the 3x3 demo
+// ./mpmcV0 bench [max_threads] [items] [capacity]
+// ./mpmcV0 check                           capacity edge cases, optional pops
+int main(int argc, char** argv) {
+    if (argc > 1 && std::strcmp(argv[1], "check") == 0) return run_check() ? 0 : 1;
+    if (argc > 1 && std::strcmp(argv[1], "bench") == 0) {
+        int hw = static_cast<int>(std::thread::hardware_concurrency());
+        int max_threads = argc > 2 ? std::atoi(argv[2]) : (hw > 1 ? hw / 2 : 1);
+        long items = argc > 3 ? std::atol(argv[3]) : 1000000;
+        long capacity = argc > 4 ? std::atol(argv[4]) : 1024;
+        // MutexQueue(0) never has room, so producers would block forever.
+        if (max_threads < 1 || items < 1 || capacity < 1) {
+            std::cerr << "max_threads, items and capacity must be at least 1\n";
+            return 1;
+        }
+        run_bench(max_threads, items, static_cast<std::size_t>(capacity));
+    } else {
+        run_demo();
+    }
+    return 0;
+}
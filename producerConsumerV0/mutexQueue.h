@@ -0,0 +1,181 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <queue>
+#include <span>
+#include <utility>
+
+// The v0.cpp buffer packaged as a class: std::queue + one mutex + two
+// condition variables, bounded at `capacity`. Kept as the baseline that the
+// lock-free queues are measured against.
+template <typename T>
+class MutexQueue {
+public:
+    explicit MutexQueue(std::size_t capacity) : capacity_(capacity) {}
+    MutexQueue(const MutexQueue&) = delete;
+    MutexQueue& operator=(const MutexQueue&) = delete;
+
+    // The value is only moved from if the push succeeds, so move-only
+    // payloads survive a failed try_push.
+    bool try_push(const T& value) { return push_if_room(value); }
+    bool try_push(T&& value) { return push_if_room(std::move(value)); }
+
+    bool try_pop(T& out) {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            if (buffer_.empty()) return false;
+            out = std::move(buffer_.front());
+            buffer_.pop();
+        }
+        notify(cv_producer_, 1);
+        return true;
+    }
+
+    // Waits while full. Returns false if the queue was closed.
+    bool push(T value) {
+        std::unique_lock<std::mutex> lock(mtx_);
+        cv_producer_.wait(lock, [this] { return buffer_.size() < capacity_ || closed_; });
+        if (closed_) return false;
+        buffer_.push(std::move(value));
+        lock.unlock();
+        notify(cv_consumer_, 1);
+        return true;
+    }
+
+    // Waits while empty. Returns false once closed and drained.
+    bool pop(T& out) {
+        std::unique_lock<std::mutex> lock(mtx_);
+        cv_consumer_.wait(lock, [this] { return !buffer_.empty() || closed_; });
+        if (buffer_.empty()) return false;
+        out = std::move(buffer_.front());
+        buffer_.pop();
+        lock.unlock();
+        notify(cv_producer_, 1);
+        return true;
+    }
+
+    // Bulk variants: move up to N items per lock acquisition and send one
+    // notification per batch instead of one per item. A batch can make room
+    // for (or satisfy) several waiters, so multi-item batches use notify_all.
+
+    // Pushes as many of `items` as fit. Returns how many were pushed.
+    std::size_t try_push_bulk(std::span<const T> items) {
+        std::size_t n = 0;
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            if (closed_) return 0;
+            n = std::min(items.size(), capacity_ - buffer_.size());
+            for (std::size_t i = 0; i < n; ++i) buffer_.push(items[i]);
+        }
+        notify(cv_consumer_, n);
+        return n;
+    }
+
+    // Pops up to `max` items into `out`. Returns how many were popped.
+    std::size_t try_pop_bulk(T* out, std::size_t max) {
+        std::size_t n = 0;
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            n = take(out, max);
+        }
+        notify(cv_producer_, n);
+        return n;
+    }
+
+    // Pushes all of `items`, waiting for room as needed; each wait/fill round
+    // is one lock and one notification. Returns fewer than items.size() only
+    // if the queue was closed.
+    std::size_t push_bulk(std::span<const T> items) {
+        std::size_t done = 0;
+        while (done < items.size()) {
+            std::size_t n = 0;
+            {
+                std::unique_lock<std::mutex> lock(mtx_);
+                cv_producer_.wait(lock, [this] { return buffer_.size() < capacity_ || closed_; });
+                if (closed_) break;
+                n = std::min(items.size() - done, capacity_ - buffer_.size());
+                for (std::size_t i = 0; i < n; ++i) buffer_.push(items[done + i]);
+            }
+            notify(cv_consumer_, n);
+            done += n;
+        }
+        return done;
+    }
+
+    // Waits until at least one item is available, then pops up to `max`.
+    // Returns 0 once closed and drained.
+    std::size_t pop_bulk(T* out, std::size_t max) {
+        std::size_t n = 0;
+        {
+            std::unique_lock<std::mutex> lock(mtx_);
+            cv_consumer_.wait(lock, [this] { return !buffer_.empty() || closed_; });
+            n = take(out, max);
+        }
+        notify(cv_producer_, n);
+        return n;
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            closed_ = true;
+        }
+        cv_producer_.notify_all();
+        cv_consumer_.notify_all();
+    }
+
+    bool closed() const {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return closed_;
+    }
+
+    std::size_t size() const {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return buffer_.size();
+    }
+    std::size_t capacity() const { return capacity_; }
+
+    // Condition-variable notifications sent so far (close() not counted).
+    std::uint64_t notifies() const { return notifies_.load(std::memory_order_relaxed); }
+
+private:
+    template <typename U>
+    bool push_if_room(U&& value) {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            if (closed_ || buffer_.size() >= capacity_) return false;
+            buffer_.push(std::forward<U>(value));
+        }
+        notify(cv_consumer_, 1);
+        return true;
+    }
+
+    std::size_t take(T* out, std::size_t max) {
+        const std::size_t n = std::min(max, buffer_.size());
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = std::move(buffer_.front());
+            buffer_.pop();
+        }
+        return n;
+    }
+
+    // One notify_one/notify_all for n items moved; counted in notifies().
+    void notify(std::condition_variable& cv, std::size_t n) {
+        if (n == 0) return;
+        notifies_.fetch_add(1, std::memory_order_relaxed);
+        if (n == 1) cv.notify_one();
+        else cv.notify_all();
+    }
+
+    const std::size_t capacity_;
+    std::queue<T> buffer_;
+    mutable std::mutex mtx_;
+    std::condition_variable cv_producer_, cv_consumer_;
+    bool closed_ = false;
+    std::atomic<std::uint64_t> notifies_{0};
+};
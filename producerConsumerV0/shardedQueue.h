@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "cacheLine.h"
+#include "mpmcQueue.h"
+#include "waitStrategy.h"
+
+// Sharded producer/consumer buffer: one bounded shard per producer.
+//
+// Producer p only ever writes shard p, so producers never share a queue
+// tail. Consumers are statically affined to shards (consumer c owns every
+// shard s with s % consumers == c) and only scan other shards when all of
+// their own are empty, so in steady state each shard's head is touched by
+// one consumer too. Ordering is FIFO per shard only, not global.
+//
+// Backpressure is per shard: a producer blocks when *its* shard holds
+// `capacity_per_shard` items (MAX_BUFFER_SIZE in v0.cpp), regardless of how
+// empty the other shards are.
+template <typename T>
+class ShardedQueue {
+public:
+    // Throws std::invalid_argument for shards == 0 (a producer picks its
+    // shard with `% shards`).
+    ShardedQueue(std::size_t shards, std::size_t consumers, std::size_t capacity_per_shard, WaitPolicy policy = {})
+        : consumers_(consumers ? consumers : 1), policy_(policy) {
+        if (shards == 0) throw std::invalid_argument("ShardedQueue needs at least one shard");
+        for (std::size_t i = 0; i < shards; ++i)
+            shards_.emplace_back(new MpmcQueue<T>(capacity_per_shard, policy));
+    }
+    ShardedQueue(const ShardedQueue&) = delete;
+    ShardedQueue& operator=(const ShardedQueue&) = delete;
+
+    std::size_t shards() const { return shards_.size(); }
+
+    // Producer side; `producer` selects the shard. Waits while that shard is
+    // full. Returns false if the queue was closed.
+    bool push(std::size_t producer, T value) {
+        if (!shards_[producer % shards_.size()]->push(std::move(value))) return false;
+        not_empty_.notify_one();
+        return true;
+    }
+
+    bool try_push(std::size_t producer, T value) {
+        if (!shards_[producer % shards_.size()]->try_push(std::move(value))) return false;
+        not_empty_.notify_one();
+        return true;
+    }
+
+    std::size_t push_bulk(std::size_t producer, std::span<const T> items) {
+        const std::size_t n = shards_[producer % shards_.size()]->push_bulk(items);
+        if (n == 1) not_empty_.notify_one();
+        else if (n > 1) not_empty_.notify_all();
+        return n;
+    }
+
+    // Consumer side: own shards first, then the others. Returns false if
+    // every shard is empty.
+    bool try_pop(std::size_t consumer, T& out) {
+        const std::size_t n = shards_.size();
+        // With more consumers than shards several consumers share one home shard.
+        const std::size_t stride = consumers_ < n ? consumers_ : n;
+        const std::size_t home = (consumer % consumers_) % n;
+        for (std::size_t s = home; s < n; s += stride)
+            if (shards_[s]->try_pop(out)) return true;
+        for (std::size_t k = 1; k < n; ++k) {
+            const std::size_t s = (home + k) % n;
+            if (s % stride == home % stride) continue;  // own shard, already checked
+            if (shards_[s]->try_pop(out)) return true;
+        }
+        return false;
+    }
+
+    // Waits while every shard is empty. Returns false once closed and drained.
+    bool pop(std::size_t consumer, T& out) {
+        bool ok = false;
+        not_empty_.wait_until([&] { return (ok = try_pop(consumer, out)) || closed(); }, policy_);
+        if (!ok) ok = try_pop(consumer, out);
+        return ok;
+    }
+
+    void close() {
+        closed_.store(true, std::memory_order_release);
+        for (auto& s : shards_) s->close();
+        not_empty_.notify_all();
+    }
+    bool closed() const { return closed_.load(std::memory_order_acquire); }
+
+private:
+    std::vector<std::unique_ptr<MpmcQueue<T>>> shards_;
+    const std::size_t consumers_;
+    const WaitPolicy policy_;
+
+    alignas(kCacheLineSize) std::atomic<bool> closed_{false};
+    Parker not_empty_;  // consumers wait here when every shard is empty
+};
@@ -0,0 +1,95 @@
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <atomic>
+#include <algorithm>
+#include <cstdlib>
+
+#include "mpmcQueue.h"
+#include "shardedQueue.h"
+
+// One global MpmcQueue vs ShardedQueue (one shard per producer, consumers
+// affined to shards). Both get the same total buffering: the global queue
+// holds producers * capacity_per_shard items.
+
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+    double items_per_sec;
+    bool ok;
+};
+
+Result bench_global(int producers_n, int consumers_n, long items_per_producer, std::size_t cap_per_shard) {
+    MpmcQueue<long> q(cap_per_shard * producers_n);
+    std::atomic<long long> sum{0};
+    std::vector<std::thread> producers, consumers;
+
+    auto start = Clock::now();
+    for (int p = 0; p < producers_n; ++p)
+        producers.emplace_back([&] {
+            for (long i = 1; i <= items_per_producer; ++i) q.push(i);
+        });
+    for (int c = 0; c < consumers_n; ++c)
+        consumers.emplace_back([&] {
+            long long local = 0;
+            long item;
+            while (q.pop(item)) local += item;
+            sum += local;
+        });
+    for (auto& t : producers) t.join();
+    q.close();
+    for (auto& t : consumers) t.join();
+    std::chrono::duration<double> secs = Clock::now() - start;
+
+    long long expected = producers_n * (items_per_producer * (items_per_producer + 1) / 2);
+    return {producers_n * items_per_producer / secs.count(), sum == expected};
+}
+
+Result bench_sharded(int producers_n, int consumers_n, long items_per_producer, std::size_t cap_per_shard) {
+    ShardedQueue<long> q(producers_n, consumers_n, cap_per_shard);
+    std::atomic<long long> sum{0};
+    std::vector<std::thread> producers, consumers;
+
+    auto start = Clock::now();
+    for (int p = 0; p < producers_n; ++p)
+        producers.emplace_back([&, p] {
+            for (long i = 1; i <= items_per_producer; ++i) q.push(p, i);
+        });
+    for (int c = 0; c < consumers_n; ++c)
+        consumers.emplace_back([&, c] {
+            long long local = 0;
+            long item;
+            while (q.pop(c, item)) local += item;
+            sum += local;
+        });
+    for (auto& t : producers) t.join();
+    q.close();
+    for (auto& t : consumers) t.join();
+    std::chrono::duration<double> secs = Clock::now() - start;
+
+    long long expected = producers_n * (items_per_producer * (items_per_producer + 1) / 2);
+    return {producers_n * items_per_producer / secs.count(), sum == expected};
+}
+
+// ./shardedV0 [max_threads_per_side] [items_per_producer] [capacity_per_shard]
+int main(int argc, char** argv) {
+    unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    int max_threads = argc > 1 ? std::atoi(argv[1]) : std::max(1u, hw / 2);
+    long items = argc > 2 ? std::atol(argv[2]) : 1000000;
+    std::size_t cap = argc > 3 ? std::atol(argv[3]) : 256;
+
+    std::cout << items << " items per producer, " << cap << " slots per shard\n";
+    std::cout << "P x C\tglobal mpmc (M/s)\tsharded (M/s)\n";
+    for (int p = 1;; p = std::min(p * 2, max_threads)) {
+        for (int c : {std::max(1, p / 2), p}) {
+            Result g = bench_global(p, c, items, cap);
+            Result s = bench_sharded(p, c, items, cap);
+            std::cout << p << " x " << c << "\t" << g.items_per_sec / 1e6 << "\t" << s.items_per_sec / 1e6
+                      << ((g.ok && s.ok) ? "" : "\tCHECKSUM MISMATCH") << "\n";
+            if (p == 1) break;
+        }
+        if (p >= max_threads) break;
+    }
+    return 0;
+}
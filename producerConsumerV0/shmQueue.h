@@ -0,0 +1,300 @@
+#pragma once
+
+#if !defined(__linux__)
+#error "shmQueue.h needs Linux: it waits on process-shared futexes"
+#endif
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "cacheLine.h"
+#include "waitStrategy.h"
+
+// Bounded producer/consumer queue shared between processes.
+//
+// The queue in v0.cpp and the sem_t in semaphoreV0.cpp only work inside one
+// process. ShmQueue lives entirely in a shm_open/mmap region:
+//
+//   [ Header | slot 0 | slot 1 | ... | slot N-1 ]
+//
+// Every slot has a fixed number of payload bytes and the same sequence
+// protocol as MpmcQueue (seq == pos: free, pos + 1: filled, pos + slots:
+// consumed). The region holds no pointers, only sizes and offsets from its
+// own base, so each process may map it at a different address.
+//
+// Records are not copied through the queue: a producer claims a slot, writes
+// the record straight into the shared mapping and commits it; a consumer
+// claims the filled slot, reads it in place and commits it back:
+//
+//   auto q = ShmQueue::create("/orders", 1024, 4096);   // process A
+//   ShmQueue::Slot s;
+//   q.begin_push(s);  build_order(s.data, s.capacity);  s.length = n;  q.commit_push(s);
+//
+//   auto q = ShmQueue::open("/orders");                  // process B
+//   while (q.begin_pop(s)) { handle(s.data, s.length); q.commit_pop(s); }
+//
+// Blocking calls spin, yield and then sleep on process-shared futexes
+// (SharedParker), so a wake crosses the process boundary.
+//
+// A process that dies between begin_* and commit_* leaves its slot claimed
+// and the queue stalls at that position; there is no recovery protocol.
+class ShmQueue {
+public:
+    // A claimed slot. `data` points into the shared mapping and is valid
+    // until the matching commit.
+    struct Slot {
+        unsigned char* data = nullptr;
+        std::uint32_t capacity = 0;  // payload bytes available
+        std::uint32_t length = 0;    // bytes used (set by the producer)
+        std::uint64_t pos = 0;
+    };
+
+    // Creates, sizes and maps a new region (fails if `name` exists). Needs
+    // at least 2 slots, for the same reason as MpmcQueue.
+    static ShmQueue create(const std::string& name, std::uint32_t slots, std::uint32_t slot_bytes,
+                           WaitPolicy policy = {}) {
+        if (slots < 2) throw std::system_error(EINVAL, std::generic_category(), name + ": need at least 2 slots");
+        const int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0) throw std::system_error(errno, std::generic_category(), "shm_open " + name);
+        const std::size_t stride = slot_stride(slot_bytes);
+        const std::size_t bytes = sizeof(Header) + stride * slots;
+        if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+            const int err = errno;
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            throw std::system_error(err, std::generic_category(), "ftruncate " + name);
+        }
+        void* base;
+        try {
+            base = map(fd, bytes, name);
+        } catch (...) {
+            ::shm_unlink(name.c_str());
+            throw;
+        }
+        ShmQueue q(base, bytes, policy);
+
+        // The new region is zero-filled, so the atomics already hold 0.
+        Header* h = q.header();
+        h->slots = slots;
+        h->slot_bytes = slot_bytes;
+        h->stride = stride;
+        for (std::uint32_t i = 0; i < slots; ++i) q.slot(i)->seq.store(i, std::memory_order_relaxed);
+        h->magic.store(kMagic, std::memory_order_release);  // publish the layout last
+        return q;
+    }
+
+    // Maps a region created by another process. The layout is read and
+    // checked against the region's size before anything is mapped.
+    static ShmQueue open(const std::string& name, WaitPolicy policy = {}) {
+        const int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+        if (fd < 0) throw std::system_error(errno, std::generic_category(), "shm_open " + name);
+        struct stat st;
+        Layout l;
+        if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(Header) ||
+            ::pread(fd, &l, sizeof(l), 0) != static_cast<ssize_t>(sizeof(l))) {
+            ::close(fd);
+            throw std::system_error(EINVAL, std::generic_category(), name + " is not a queue");
+        }
+        if (l.magic != kMagic) {
+            ::close(fd);
+            throw std::system_error(EINVAL, std::generic_category(), name + " is not initialised");
+        }
+        const std::size_t bytes = static_cast<std::size_t>(st.st_size);
+        if (l.slots < 2 || l.stride != slot_stride(l.slot_bytes) ||
+            (bytes - sizeof(Header)) / l.stride < l.slots) {
+            ::close(fd);
+            throw std::system_error(EINVAL, std::generic_category(), name + " has a corrupt layout");
+        }
+        ShmQueue q(map(fd, bytes, name), bytes, policy);
+        if (q.header()->magic.load(std::memory_order_acquire) != kMagic)
+            throw std::system_error(EINVAL, std::generic_category(), name + " is not initialised");
+        return q;
+    }
+
+    // Removes the name; regions that are already mapped stay valid.
+    static void unlink(const std::string& name) { ::shm_unlink(name.c_str()); }
+
+    ShmQueue(ShmQueue&& other) noexcept
+        : base_(std::exchange(other.base_, nullptr)), bytes_(other.bytes_), policy_(other.policy_) {}
+    ShmQueue& operator=(ShmQueue&&) = delete;
+    ShmQueue(const ShmQueue&) = delete;
+    ShmQueue& operator=(const ShmQueue&) = delete;
+    ~ShmQueue() {
+        if (base_) ::munmap(base_, bytes_);
+    }
+
+    // Zero-copy interface.
+
+    // Claims a free slot. Returns false if the queue is full.
+    bool try_begin_push(Slot& s) { return claim(s, enqueue_pos(), 0); }
+
+    // Claims a free slot, waiting while full. Returns false if closed.
+    bool begin_push(Slot& s) {
+        bool ok = false;
+        header()->not_full.wait_until([&] { return closed() || (ok = claim(s, enqueue_pos(), 0)); }, policy_);
+        return ok;
+    }
+
+    // Publishes the first `s.length` bytes of the slot to consumers.
+    void commit_push(const Slot& s) {
+        SlotHeader* sh = slot(s.pos % header()->slots);
+        sh->length = s.length;
+        sh->seq.store(s.pos + 1, std::memory_order_release);
+        header()->not_empty.notify_one();
+    }
+
+    // Claims a filled slot. Returns false if the queue is empty.
+    bool try_begin_pop(Slot& s) { return claim(s, dequeue_pos(), 1); }
+
+    // Claims a filled slot, waiting while empty. Returns false once closed
+    // and drained.
+    bool begin_pop(Slot& s) {
+        bool ok = false;
+        header()->not_empty.wait_until([&] { return (ok = claim(s, dequeue_pos(), 1)) || closed(); }, policy_);
+        if (!ok) ok = claim(s, dequeue_pos(), 1);  // closed: drain what is left
+        return ok;
+    }
+
+    // Hands the slot back to producers.
+    void commit_pop(const Slot& s) {
+        slot(s.pos % header()->slots)->seq.store(s.pos + header()->slots, std::memory_order_release);
+        header()->not_full.notify_one();
+    }
+
+    // Copying conveniences on top of the slot interface.
+
+    // Waits for room and copies `length` bytes in. Returns false if closed
+    // or if the record does not fit (length > slot_bytes()).
+    bool push(const void* data, std::uint32_t length) {
+        if (length > slot_bytes()) return false;
+        Slot s;
+        if (!begin_push(s)) return false;
+        std::memcpy(s.data, data, length);
+        s.length = length;
+        commit_push(s);
+        return true;
+    }
+
+    // Waits for a record and copies at most `max` bytes of it out; `length`
+    // receives the record's full size.
+    bool pop(void* out, std::uint32_t max, std::uint32_t& length) {
+        Slot s;
+        if (!begin_pop(s)) return false;
+        length = s.length;
+        std::memcpy(out, s.data, length < max ? length : max);
+        commit_pop(s);
+        return true;
+    }
+
+    void close() {
+        header()->closed.store(1, std::memory_order_release);
+        header()->not_full.notify_all();
+        header()->not_empty.notify_all();
+    }
+    bool closed() const { return header()->closed.load(std::memory_order_acquire) != 0; }
+
+    std::uint32_t capacity() const { return header()->slots; }
+    std::uint32_t slot_bytes() const { return header()->slot_bytes; }
+
+private:
+    static constexpr std::uint64_t kMagic = 0x5348'4d51'5545'0001ull;  // "SHMQUE" v1
+
+    // Only lock-free atomics are address-free, i.e. work through two mappings.
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+    static_assert(std::atomic<std::uint32_t>::is_always_lock_free);
+
+    struct Header {
+        std::atomic<std::uint64_t> magic;
+        std::uint32_t slots;
+        std::uint32_t slot_bytes;
+        std::uint64_t stride;  // bytes from one slot to the next
+
+        alignas(kCacheLineSize) std::atomic<std::uint64_t> enqueue_pos;
+        alignas(kCacheLineSize) std::atomic<std::uint64_t> dequeue_pos;
+        alignas(kCacheLineSize) std::atomic<std::uint32_t> closed;
+
+        SharedParker not_full;   // producers wait here
+        SharedParker not_empty;  // consumers wait here
+    };
+
+    // The start of Header as plain integers, so open() can pread() and check
+    // it before mapping the region.
+    struct Layout {
+        std::uint64_t magic;
+        std::uint32_t slots;
+        std::uint32_t slot_bytes;
+        std::uint64_t stride;
+    };
+
+    // Each slot starts on a cache line: sequence word and length, then the payload.
+    struct SlotHeader {
+        std::atomic<std::uint64_t> seq;
+        std::uint32_t length;
+    };
+    static constexpr std::size_t kPayloadOffset = 16;
+    static_assert(sizeof(SlotHeader) <= kPayloadOffset);
+    static_assert(offsetof(Header, slots) == offsetof(Layout, slots) &&
+                  offsetof(Header, slot_bytes) == offsetof(Layout, slot_bytes) &&
+                  offsetof(Header, stride) == offsetof(Layout, stride));
+
+    static std::size_t slot_stride(std::uint32_t slot_bytes) {
+        return (kPayloadOffset + slot_bytes + kCacheLineSize - 1) / kCacheLineSize * kCacheLineSize;
+    }
+
+    static void* map(int fd, std::size_t bytes, const std::string& name) {
+        void* base = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        const int err = errno;
+        ::close(fd);  // the mapping keeps the region alive
+        if (base == MAP_FAILED) throw std::system_error(err, std::generic_category(), "mmap " + name);
+        return base;
+    }
+
+    ShmQueue(void* base, std::size_t bytes, WaitPolicy policy) : base_(base), bytes_(bytes), policy_(policy) {}
+
+    Header* header() const { return static_cast<Header*>(base_); }
+    unsigned char* bytes_at(std::size_t offset) const { return static_cast<unsigned char*>(base_) + offset; }
+    SlotHeader* slot(std::uint64_t index) const {
+        return reinterpret_cast<SlotHeader*>(bytes_at(sizeof(Header) + index * header()->stride));
+    }
+    std::atomic<std::uint64_t>& enqueue_pos() const { return header()->enqueue_pos; }
+    std::atomic<std::uint64_t>& dequeue_pos() const { return header()->dequeue_pos; }
+
+    // Claims the slot at `counter` whose sequence is pos + lag (lag 0: free
+    // for producers, lag 1: filled for consumers).
+    bool claim(Slot& s, std::atomic<std::uint64_t>& counter, std::uint64_t lag) {
+        const std::uint64_t slots = header()->slots;
+        std::uint64_t pos = counter.load(std::memory_order_relaxed);
+        for (;;) {
+            SlotHeader* sh = slot(pos % slots);
+            const std::uint64_t seq = sh->seq.load(std::memory_order_acquire);
+            const std::int64_t diff = static_cast<std::int64_t>(seq) - static_cast<std::int64_t>(pos + lag);
+            if (diff == 0) {
+                if (counter.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    s.data = reinterpret_cast<unsigned char*>(sh) + kPayloadOffset;
+                    s.capacity = header()->slot_bytes;
+                    s.length = lag ? sh->length : 0;
+                    s.pos = pos;
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // full (producers) or empty (consumers)
+            } else {
+                pos = counter.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void* base_;
+    std::size_t bytes_;
+    WaitPolicy policy_;  // per process, not part of the shared layout
+};
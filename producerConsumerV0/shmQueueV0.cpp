@@ -0,0 +1,183 @@
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "shmQueue.h"
+
+// Moving fixed-size records from a producer process to a consumer process:
+//   shm     ShmQueue in a shm_open region; the record is built in the slot
+//           and read in place, no copies and no syscalls while both run
+//   pipe    pipe(2): write() + read(), two copies through the kernel
+//   socket  AF_UNIX SOCK_STREAM socketpair, same
+// The consumer is a fork()ed child. It sums the sequence numbers it sees and
+// sends the sum back, so the parent can check nothing was lost or reordered
+// into garbage.
+
+using Clock = std::chrono::steady_clock;
+
+// Producer side: fill a record as a real producer would.
+void build(unsigned char* rec, std::uint32_t bytes, std::uint64_t seq) {
+    std::memcpy(rec, &seq, sizeof(seq));
+    std::memset(rec + sizeof(seq), static_cast<int>(seq), bytes - sizeof(seq));
+}
+
+// Consumer side: read the sequence number and the last byte.
+std::uint64_t inspect(const unsigned char* rec, std::uint32_t bytes, bool& ok) {
+    std::uint64_t seq;
+    std::memcpy(&seq, rec, sizeof(seq));
+    if (rec[bytes - 1] != static_cast<unsigned char>(seq)) ok = false;
+    return seq;
+}
+
+bool write_all(int fd, const void* p, std::size_t n) {
+    const char* c = static_cast<const char*>(p);
+    while (n > 0) {
+        ssize_t w = ::write(fd, c, n);
+        if (w <= 0) return false;
+        c += w;
+        n -= static_cast<std::size_t>(w);
+    }
+    return true;
+}
+
+bool read_all(int fd, void* p, std::size_t n) {
+    char* c = static_cast<char*>(p);
+    while (n > 0) {
+        ssize_t r = ::read(fd, c, n);
+        if (r <= 0) return false;
+        c += r;
+        n -= static_cast<std::size_t>(r);
+    }
+    return true;
+}
+
+// Forks a consumer running `consume()` (which returns the sequence sum, or
+// 0 on a corrupt record), runs `produce()` here and returns the elapsed time.
+// The expected sum is checked against what the child reports.
+template <typename Produce, typename Consume>
+double run(long items, Produce produce, Consume consume, bool& ok) {
+    int result[2];
+    if (::pipe(result) != 0) std::exit(1);
+
+    auto start = Clock::now();
+    pid_t child = ::fork();
+    if (child == 0) {
+        ::close(result[0]);
+        std::uint64_t sum = consume();
+        write_all(result[1], &sum, sizeof(sum));
+        ::_exit(0);  // skip the parent's destructors (they own the mappings/fds)
+    }
+    ::close(result[1]);
+    produce();
+    std::uint64_t sum = 0;
+    read_all(result[0], &sum, sizeof(sum));
+    std::chrono::duration<double> secs = Clock::now() - start;
+    ::close(result[0]);
+    ::waitpid(child, nullptr, 0);
+
+    ok = sum == static_cast<std::uint64_t>(items) * (items + 1) / 2;
+    return secs.count();
+}
+
+double bench_shm(std::uint32_t bytes, long items, std::uint32_t slots, bool& ok) {
+    const std::string name = "/shmQueueV0." + std::to_string(::getpid());
+    ShmQueue::unlink(name);
+    ShmQueue q = ShmQueue::create(name, slots, bytes);
+    double secs = run(
+        items,
+        [&] {
+            ShmQueue::Slot s;
+            for (long i = 1; i <= items; ++i) {
+                q.begin_push(s);
+                build(s.data, bytes, static_cast<std::uint64_t>(i));
+                s.length = bytes;
+                q.commit_push(s);
+            }
+            q.close();
+        },
+        [&] {
+            // Map the region again by name, as an unrelated process would.
+            ShmQueue mine = ShmQueue::open(name);
+            std::uint64_t sum = 0;
+            bool good = true;
+            ShmQueue::Slot s;
+            while (mine.begin_pop(s)) {
+                sum += inspect(s.data, s.length, good);
+                mine.commit_pop(s);
+            }
+            return good ? sum : 0;
+        },
+        ok);
+    ShmQueue::unlink(name);
+    return secs;
+}
+
+// pipe and socket differ only in how the fd pair is made.
+double bench_stream(int fds[2], std::uint32_t bytes, long items, bool& ok) {
+    double secs = run(
+        items,
+        [&] {
+            ::close(fds[0]);
+            std::vector<unsigned char> rec(bytes);
+            for (long i = 1; i <= items; ++i) {
+                build(rec.data(), bytes, static_cast<std::uint64_t>(i));
+                write_all(fds[1], rec.data(), bytes);
+            }
+            ::close(fds[1]);
+        },
+        [&] {
+            ::close(fds[1]);
+            std::vector<unsigned char> rec(bytes);
+            std::uint64_t sum = 0;
+            bool good = true;
+            while (read_all(fds[0], rec.data(), bytes)) sum += inspect(rec.data(), bytes, good);
+            return good ? sum : 0;
+        },
+        ok);
+    return secs;
+}
+
+double bench_pipe(std::uint32_t bytes, long items, bool& ok) {
+    int fds[2];
+    if (::pipe(fds) != 0) std::exit(1);
+    return bench_stream(fds, bytes, items, ok);
+}
+
+double bench_socket(std::uint32_t bytes, long items, bool& ok) {
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) std::exit(1);
+    return bench_stream(fds, bytes, items, ok);
+}
+
+// ./shmQueueV0 [items] [slots]
+int main(int argc, char** argv) {
+    long items = argc > 1 ? std::atol(argv[1]) : 200000;
+    std::uint32_t slots = argc > 2 ? static_cast<std::uint32_t>(std::atol(argv[2])) : 256;
+
+    std::cout << "1 producer process -> 1 consumer process, " << items << " records, " << slots
+              << " shm slots\n";
+    std::cout << "bytes\tmode\tM rec/s\tMB/s\n";
+    for (std::uint32_t bytes : {64u, 1024u, 4096u}) {
+        auto print = [&](const char* name, double secs, bool ok) {
+            std::cout << bytes << "\t" << name << "\t" << items / secs / 1e6 << "\t"
+                      << items * static_cast<double>(bytes) / secs / 1e6 << (ok ? "" : "\tCHECKSUM MISMATCH")
+                      << "\n";
+        };
+        bool ok = false;
+        double secs = bench_shm(bytes, items, slots, ok);
+        print("shm", secs, ok);
+        secs = bench_pipe(bytes, items, ok);
+        print("pipe", secs, ok);
+        secs = bench_socket(bytes, items, ok);
+        print("socket", secs, ok);
+    }
+    return 0;
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include "cacheLine.h"
+#include "mpmcQueue.h"
+#include "waitStrategy.h"
+
+// Preallocated message storage for the producer/consumer queues.
+//
+// Wrapping 64B-4KB records in std::unique_ptr costs a malloc and a free per
+// item. With a SlabPool the producer claims a slot, constructs the message
+// in place and pushes only a 4-byte SlabHandle through the queue; the
+// consumer reads the message and releases the slot:
+//
+//   SlabPool<Msg> pool(1024);
+//   MpmcQueue<SlabHandle> q(1024);
+//   // producer
+//   SlabHandle h = pool.emplace(args...);   // waits if every slot is in use
+//   q.push(h);
+//   // consumer
+//   SlabHandle h; q.pop(h);
+//   use(pool[h]);
+//   pool.release(h);
+//
+// Free slot indices live in an MpmcQueue, so claim/release are lock-free and
+// a drained pool gives producers the same backpressure as a full queue. No
+// heap allocation happens after construction.
+struct SlabHandle {
+    std::uint32_t index;
+};
+
+template <typename T>
+class SlabPool {
+public:
+    // Throws std::invalid_argument unless 1 <= slots < 2^32 (handles are
+    // 32-bit indices, and an empty pool would block every emplace forever).
+    explicit SlabPool(std::size_t slots, WaitPolicy policy = {})
+        : slots_(checked_slots(slots)),
+          memory_(static_cast<unsigned char*>(::operator new(slots * kStride, std::align_val_t(kCacheLineSize)))),
+          free_(slots, policy) {
+        for (std::size_t i = 0; i < slots; ++i) free_.try_push(static_cast<std::uint32_t>(i));
+    }
+
+    // Every handle must have been released by now.
+    ~SlabPool() { ::operator delete(memory_, std::align_val_t(kCacheLineSize)); }
+
+    SlabPool(const SlabPool&) = delete;
+    SlabPool& operator=(const SlabPool&) = delete;
+
+    // Constructs a T in a free slot. Returns false if every slot is in use.
+    template <typename... Args>
+    bool try_emplace(SlabHandle& out, Args&&... args) {
+        std::uint32_t index;
+        if (!free_.try_pop(index)) return false;
+        ::new (static_cast<void*>(slot(index))) T(std::forward<Args>(args)...);
+        out = SlabHandle{index};
+        return true;
+    }
+
+    // Constructs a T in a free slot, waiting for one to be released.
+    template <typename... Args>
+    SlabHandle emplace(Args&&... args) {
+        std::uint32_t index = 0;
+        free_.pop(index);  // the free list is never closed
+        ::new (static_cast<void*>(slot(index))) T(std::forward<Args>(args)...);
+        return SlabHandle{index};
+    }
+
+    T& operator[](SlabHandle h) { return *std::launder(reinterpret_cast<T*>(slot(h.index))); }
+    const T& operator[](SlabHandle h) const { return *std::launder(reinterpret_cast<const T*>(slot(h.index))); }
+
+    // Destroys the message and returns its slot to the pool.
+    void release(SlabHandle h) {
+        (*this)[h].~T();
+        free_.push(h.index);  // cannot be full: at most `slots` indices exist
+    }
+
+    std::size_t capacity() const { return slots_; }
+
+private:
+    // Slots are padded to whole cache lines so neighbouring messages owned by
+    // different threads never share a line.
+    static constexpr std::size_t kStride =
+        (sizeof(T) + kCacheLineSize - 1) / kCacheLineSize * kCacheLineSize;
+    static_assert(alignof(T) <= kCacheLineSize, "over-aligned payloads are not supported");
+
+    static std::size_t checked_slots(std::size_t slots) {
+        if (slots == 0 || slots > UINT32_MAX) throw std::invalid_argument("SlabPool needs 1 to 2^32-1 slots");
+        return slots;
+    }
+
+    unsigned char* slot(std::uint32_t index) const { return memory_ + static_cast<std::size_t>(index) * kStride; }
+
+    const std::size_t slots_;
+    unsigned char* const memory_;
+    MpmcQueue<std::uint32_t> free_;
+};
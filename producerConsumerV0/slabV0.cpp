@@ -0,0 +1,139 @@
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "mpmcQueue.h"
+#include "slabPool.h"
+
+// Moving 64B-4KB messages through the queue three ways:
+//   by value     MpmcQueue<Msg>: the whole record is copied into the slot
+//   unique_ptr   MpmcQueue<std::unique_ptr<Msg>>: one new + delete per item
+//   slab         SlabPool<Msg> + MpmcQueue<SlabHandle>: constructed in place,
+//                only a 4-byte handle moves through the queue
+// and counting heap allocations during the run.
+
+std::atomic<long> g_allocations{0};
+
+void* operator new(std::size_t n) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+using Clock = std::chrono::steady_clock;
+
+template <std::size_t Bytes>
+struct Msg {
+    std::uint64_t seq;
+    char body[Bytes - sizeof(std::uint64_t)];
+
+    Msg() = default;
+    explicit Msg(std::uint64_t s) : seq(s) { std::memset(body, static_cast<int>(s), sizeof(body)); }
+};
+
+struct Result {
+    double items_per_sec;
+    double allocs_per_item;
+    bool ok;
+};
+
+// Runs `producers` x `consumers` threads; produce(i) and consume() supply the mode.
+template <typename Produce, typename Consume, typename Close>
+Result run(int producers_n, int consumers_n, long items_per_producer, Produce produce, Consume consume,
+           Close close) {
+    std::atomic<long long> sum{0};
+    std::vector<std::thread> producers, consumers;
+    consumers.reserve(consumers_n);
+    producers.reserve(producers_n);
+
+    long allocs_before = g_allocations.load();
+    auto start = Clock::now();
+    for (int c = 0; c < consumers_n; ++c)
+        consumers.emplace_back([&] {
+            long long local = 0;
+            std::uint64_t seq;
+            while (consume(seq)) local += static_cast<long long>(seq);
+            sum += local;
+        });
+    for (int p = 0; p < producers_n; ++p)
+        producers.emplace_back([&] {
+            for (long i = 1; i <= items_per_producer; ++i) produce(static_cast<std::uint64_t>(i));
+        });
+    for (auto& t : producers) t.join();
+    close();
+    for (auto& t : consumers) t.join();
+    std::chrono::duration<double> secs = Clock::now() - start;
+    long allocs = g_allocations.load() - allocs_before - producers_n - consumers_n;  // thread start-up
+
+    const long total = producers_n * items_per_producer;
+    long long expected = producers_n * (items_per_producer * (items_per_producer + 1) / 2);
+    return {total / secs.count(), static_cast<double>(allocs) / total, sum == expected};
+}
+
+template <std::size_t Bytes>
+void bench(int p, int c, long items, std::size_t capacity) {
+    using M = Msg<Bytes>;
+    auto print = [](const char* name, Result r) {
+        std::cout << Bytes << "\t" << name << "\t" << r.items_per_sec / 1e6 << "\t" << r.allocs_per_item
+                  << (r.ok ? "" : "\tCHECKSUM MISMATCH") << "\n";
+    };
+    {
+        MpmcQueue<M> q(capacity);
+        print("by value", run(p, c, items, [&](std::uint64_t i) { q.push(M(i)); },
+                              [&](std::uint64_t& seq) {
+                                  M m;
+                                  if (!q.pop(m)) return false;
+                                  seq = m.seq;
+                                  return true;
+                              },
+                              [&] { q.close(); }));
+    }
+    {
+        MpmcQueue<std::unique_ptr<M>> q(capacity);
+        print("unique_ptr", run(p, c, items, [&](std::uint64_t i) { q.push(std::make_unique<M>(i)); },
+                                [&](std::uint64_t& seq) {
+                                    std::unique_ptr<M> m;
+                                    if (!q.pop(m)) return false;
+                                    seq = m->seq;
+                                    return true;
+                                },
+                                [&] { q.close(); }));
+    }
+    {
+        SlabPool<M> pool(capacity * 2);
+        MpmcQueue<SlabHandle> q(capacity);
+        print("slab", run(p, c, items, [&](std::uint64_t i) { q.push(pool.emplace(i)); },
+                          [&](std::uint64_t& seq) {
+                              SlabHandle h;
+                              if (!q.pop(h)) return false;
+                              seq = pool[h].seq;
+                              pool.release(h);
+                              return true;
+                          },
+                          [&] { q.close(); }));
+    }
+}
+
+// ./slabV0 [producers] [consumers] [items_per_producer] [capacity]
+int main(int argc, char** argv) {
+    int p = argc > 1 ? std::atoi(argv[1]) : 1;
+    int c = argc > 2 ? std::atoi(argv[2]) : 1;
+    long items = argc > 3 ? std::atol(argv[3]) : 500000;
+    std::size_t capacity = argc > 4 ? std::atol(argv[4]) : 256;
+
+    std::cout << p << " producers x " << c << " consumers, " << items << " items per producer\n";
+    std::cout << "bytes\tmode\tM items/s\tallocs/item\n";
+    bench<64>(p, c, items, capacity);
+    bench<512>(p, c, items, capacity);
+    bench<4096>(p, c, items, capacity);
+    return 0;
+}
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <span>
+#include <utility>
+
+#include "cacheLine.h"
+#include "waitStrategy.h"
+
+// Bounded single-producer / single-consumer ring buffer.
+//
+// head_ is only written by the consumer, tail_ only by the producer, so the
+// handoff needs no lock and no read-modify-write: the producer publishes a
+// slot with a release store of tail_, the consumer acquires it and frees the
+// slot with a release store of head_.
+//
+// Each side also keeps a cached copy of the other side's index and only
+// re-reads the shared one when the cache says "full"/"empty". That keeps the
+// common case to one cache line owned by each thread.
+//
+// Indices grow monotonically and are reduced with `% Capacity`, so any
+// capacity works (e.g. MAX_BUFFER_SIZE = 10); powers of two compile to a mask.
+//
+// T may be move-only and need not be default-constructible: try_pop() and
+// pop() without arguments return std::optional<T>.
+//
+// Blocking calls wait with the spin-then-park strategy in waitStrategy.h.
+template <typename T, std::size_t Capacity>
+class SpscRingBuffer {
+    static_assert(Capacity > 0, "Capacity must be positive");
+
+public:
+    explicit SpscRingBuffer(WaitPolicy policy = {}) : policy_(policy) {}
+    ~SpscRingBuffer() {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        for (std::size_t i = head_.load(std::memory_order_relaxed); i != tail; ++i) slot(i)->~T();
+    }
+    SpscRingBuffer(const SpscRingBuffer&) = delete;
+    SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+    // Producer side. Returns false if the buffer is full.
+    bool try_push(const T& value) { return pushed(enqueue(value)); }
+    bool try_push(T&& value) { return pushed(enqueue(std::move(value))); }
+
+    // Consumer side. Returns false if the buffer is empty.
+    bool try_pop(T& out) { return popped(dequeue(assign_to(out))); }
+
+    // nullopt if the buffer is empty. Needs no default-constructible T.
+    std::optional<T> try_pop() {
+        std::optional<T> out;
+        popped(dequeue(emplace_into(out)));
+        return out;
+    }
+
+    // Blocking push: waits while full. Returns false if the buffer was closed.
+    bool push(T value) {
+        bool ok = false;
+        not_full_.wait_until([&] { return closed() || (ok = enqueue(std::move(value))); }, policy_);
+        return pushed(ok);
+    }
+
+    // Blocking pop: waits while empty. Returns false once the buffer is
+    // closed and fully drained, mirroring `buffer.empty() && stop` in v0.cpp.
+    bool pop(T& out) {
+        bool ok = false;
+        not_empty_.wait_until([&] { return (ok = dequeue(assign_to(out))) || closed(); }, policy_);
+        if (!ok) ok = dequeue(assign_to(out));
+        return popped(ok);
+    }
+
+    // As pop(T&), nullopt once closed and drained.
+    std::optional<T> pop() {
+        std::optional<T> out;
+        not_empty_.wait_until([&] { return dequeue(emplace_into(out)) || closed(); }, policy_);
+        if (!out) dequeue(emplace_into(out));
+        popped(out.has_value());
+        return out;
+    }
+
+    // Bulk variants: copy a run of items and publish them with one index
+    // store, so the other side sees one cache-line transfer per batch.
+
+    // Pushes as many of `items` as fit. Returns how many were pushed.
+    std::size_t try_push_bulk(std::span<const T> items) {
+        const std::size_t n = enqueue_bulk(items);
+        pushed(n != 0);
+        return n;
+    }
+
+    // Pops up to `max` items into `out`. Returns how many were popped.
+    std::size_t try_pop_bulk(T* out, std::size_t max) {
+        const std::size_t n = dequeue_bulk(out, max);
+        popped(n != 0);
+        return n;
+    }
+
+    // Pushes all of `items`, waiting for room as needed. Returns fewer than
+    // items.size() only if the buffer was closed.
+    std::size_t push_bulk(std::span<const T> items) {
+        std::size_t done = 0;
+        while (done < items.size()) {
+            std::size_t n = 0;
+            not_full_.wait_until([&] { return closed() || (n = enqueue_bulk(items.subspan(done))) != 0; },
+                                 policy_);
+            if (!pushed(n != 0)) break;  // closed
+            done += n;
+        }
+        return done;
+    }
+
+    // Waits until at least one item is available, then pops up to `max`.
+    // Returns 0 once closed and drained.
+    std::size_t pop_bulk(T* out, std::size_t max) {
+        std::size_t n = 0;
+        not_empty_.wait_until([&] { return (n = dequeue_bulk(out, max)) != 0 || closed(); }, policy_);
+        if (n == 0) n = dequeue_bulk(out, max);
+        popped(n != 0);
+        return n;
+    }
+
+    // Equivalent of setting `stop = true`: producers stop, consumers drain.
+    void close() {
+        closed_.store(true, std::memory_order_release);
+        not_full_.notify_all();
+        not_empty_.notify_all();
+    }
+    bool closed() const { return closed_.load(std::memory_order_acquire); }
+
+    // Approximate when called concurrently.
+    std::size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+    bool empty() const { return size() == 0; }
+    static constexpr std::size_t capacity() { return Capacity; }
+
+    // Parker notifications sent so far, and wake syscalls among them.
+    std::uint64_t notifies() const { return not_full_.notifies() + not_empty_.notifies(); }
+    std::uint64_t wakes() const { return not_full_.wakes() + not_empty_.wakes(); }
+
+private:
+    template <typename U>
+    bool enqueue(U&& value) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ == Capacity) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ == Capacity) return false;
+        }
+        ::new (static_cast<void*>(slots_[tail % Capacity].bytes)) T(std::forward<U>(value));
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    static auto assign_to(T& out) {
+        return [&out](T&& v) { out = std::move(v); };
+    }
+    static auto emplace_into(std::optional<T>& out) {
+        return [&out](T&& v) { out.emplace(std::move(v)); };
+    }
+
+    // Moves the front element into take(T&&).
+    template <typename Take>
+    bool dequeue(Take take) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) return false;
+        }
+        take(std::move(*slot(head)));
+        slot(head)->~T();
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::size_t enqueue_bulk(std::span<const T> items) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        std::size_t room = Capacity - (tail - cached_head_);
+        if (room < items.size()) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            room = Capacity - (tail - cached_head_);
+        }
+        const std::size_t n = std::min(room, items.size());
+        for (std::size_t i = 0; i < n; ++i)
+            ::new (static_cast<void*>(slots_[(tail + i) % Capacity].bytes)) T(items[i]);
+        if (n != 0) tail_.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
+    std::size_t dequeue_bulk(T* out, std::size_t max) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        std::size_t avail = cached_tail_ - head;
+        if (avail < max) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            avail = cached_tail_ - head;
+        }
+        const std::size_t n = std::min(avail, max);
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = std::move(*slot(head + i));
+            slot(head + i)->~T();
+        }
+        if (n != 0) head_.store(head + n, std::memory_order_release);
+        return n;
+    }
+
+    // There is at most one waiter per side, so notify_one always suffices.
+    bool pushed(bool ok) {
+        if (ok) not_empty_.notify_one();
+        return ok;
+    }
+    bool popped(bool ok) {
+        if (ok) not_full_.notify_one();
+        return ok;
+    }
+
+    const WaitPolicy policy_;
+
+    // Consumer-owned line.
+    alignas(kCacheLineSize) std::atomic<std::size_t> head_{0};
+    std::size_t cached_tail_ = 0;
+
+    // Producer-owned line.
+    alignas(kCacheLineSize) std::atomic<std::size_t> tail_{0};
+    std::size_t cached_head_ = 0;
+
+    alignas(kCacheLineSize) std::atomic<bool> closed_{false};
+
+    // Raw storage, so T only has to be move-constructible.
+    struct Slot {
+        alignas(T) unsigned char bytes[sizeof(T)];
+    };
+    T* slot(std::size_t i) { return std::launder(reinterpret_cast<T*>(slots_[i % Capacity].bytes)); }
+
+    alignas(kCacheLineSize) Slot slots_[Capacity];
+
+    Parker not_full_;   // the producer waits here
+    Parker not_empty_;  // the consumer waits here
+};
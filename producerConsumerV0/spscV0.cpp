@@ -0,0 +1,135 @@
+#include <iostream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <queue>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+#include "spscRingBuffer.h"
+
+// Same bounded size as v0.cpp so the two paths are compared like for like.
+const int MAX_BUFFER_SIZE = 10;
+
+// ---------------------------------------------------------------------------
+// Demo: the v0.cpp producer/consumer with exactly one of each, using the
+// SPSC ring buffer as a drop-in for the mutex + cv_producer/cv_consumer queue.
+// ---------------------------------------------------------------------------
+SpscRingBuffer<int, MAX_BUFFER_SIZE> ring;
+
+void producer(int id) {
+    int item_id = 0;  // single producer, no shared counter needed
+    while (true) {
+        int item = ++item_id;
+        if (!ring.push(item)) break;  // closed
+        std::cout << "[Producer " << id << "] produced: " << item << "\n";
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    std::cout << "[Producer " << id << "] exiting\n";
+}
+
+void consumer(int id) {
+    int item;
+    while (ring.pop(item)) {
+        std::cout << "    [Consumer " << id << "] consumed: " << item << "\n";
+        std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    }
+    std::cout << "    [Consumer " << id << "] exiting\n";
+}
+
+void run_demo() {
+    std::thread p(producer, 0);
+    std::thread c(consumer, 0);
+
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+    ring.close();
+
+    p.join();
+    c.join();
+    std::cout << "All threads exited.\n";
+}
+
+// ---------------------------------------------------------------------------
+// Throughput comparison: no pacing, no printing, one producer, one consumer.
+// ---------------------------------------------------------------------------
+using Clock = std::chrono::steady_clock;
+
+// The v0.cpp path: std::queue + one mutex + two condition variables.
+double bench_mutex_cv(long n) {
+    std::queue<int> buffer;
+    std::mutex mtx;
+    std::condition_variable cv_producer, cv_consumer;
+    long long sum = 0;
+
+    auto start = Clock::now();
+    std::thread p([&] {
+        for (long i = 1; i <= n; ++i) {
+            std::unique_lock<std::mutex> lock(mtx);
+            cv_producer.wait(lock, [&] { return buffer.size() < MAX_BUFFER_SIZE; });
+            buffer.push(static_cast<int>(i));
+            lock.unlock();
+            cv_consumer.notify_one();
+        }
+    });
+    std::thread c([&] {
+        for (long i = 0; i < n; ++i) {
+            std::unique_lock<std::mutex> lock(mtx);
+            cv_consumer.wait(lock, [&] { return !buffer.empty(); });
+            sum += buffer.front();
+            buffer.pop();
+            lock.unlock();
+            cv_producer.notify_one();
+        }
+    });
+    p.join();
+    c.join();
+    std::chrono::duration<double> secs = Clock::now() - start;
+
+    if (sum != static_cast<long long>(n) * (n + 1) / 2) std::cerr << "mutex+cv: checksum mismatch\n";
+    return n / secs.count();
+}
+
+template <std::size_t Capacity>
+double bench_spsc(long n) {
+    auto* q = new SpscRingBuffer<int, Capacity>();
+    long long sum = 0;
+
+    auto start = Clock::now();
+    std::thread p([&] {
+        for (long i = 1; i <= n; ++i) q->push(static_cast<int>(i));
+    });
+    std::thread c([&] {
+        int item = 0;
+        for (long i = 0; i < n; ++i) {
+            q->pop(item);
+            sum += item;
+        }
+    });
+    p.join();
+    c.join();
+    std::chrono::duration<double> secs = Clock::now() - start;
+
+    if (sum != static_cast<long long>(n) * (n + 1) / 2) std::cerr << "spsc: checksum mismatch\n";
+    delete q;
+    return n / secs.count();
+}
+
+void run_bench(long n) {
+    std::cout << "items: " << n << "\n";
+    std::cout << "mutex+cv   (cap " << MAX_BUFFER_SIZE << "):   " << bench_mutex_cv(n) / 1e6 << " M items/s\n";
+    std::cout << "spsc ring  (cap " << MAX_BUFFER_SIZE << "):   " << bench_spsc<MAX_BUFFER_SIZE>(n) / 1e6 << " M items/s\n";
+    std::cout << "spsc ring  (cap 1024): " << bench_spsc<1024>(n) / 1e6 << " M items/s\n";
+}
+
+// ./spscV0            run the 1x1 demo
+// ./spscV0 bench [n]  compare mutex+cv against the ring buffer
+int main(int argc, char** argv) {
+    if (argc > 1 && std::strcmp(argv[1], "bench") == 0) {
+        long n = argc > 2 ? std::atol(argv[2]) : 5000000;
+        run_bench(n);
+    } else {
+        run_demo();
+    }
+    return 0;
+}
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "cacheLine.h"
+#include "chaseLevDeque.h"
+#include "waitStrategy.h"
+
+// Work-stealing thread pool.
+//
+// Each worker owns a ChaseLevDeque. Work spawned from inside the pool goes
+// onto the spawning worker's own deque (no shared cache line touched); work
+// submitted from outside goes through a small mutex-guarded injection queue.
+// A worker looks for work in this order:
+//   own deque (LIFO)  ->  injection queue  ->  steal from a random victim
+// and parks on a Parker when it finds nothing, so submitting to a busy pool
+// never makes a wake syscall.
+class ThreadPool {
+public:
+    // Throws std::invalid_argument for threads == 0: victim selection and
+    // parallel_for's default grain divide by the worker count.
+    explicit ThreadPool(unsigned threads = std::max(1u, std::thread::hardware_concurrency())) {
+        if (threads == 0) throw std::invalid_argument("ThreadPool needs at least one worker");
+        for (unsigned i = 0; i < threads; ++i)
+            workers_.emplace_back(new Worker);
+        for (unsigned i = 0; i < threads; ++i)
+            workers_[i]->thread = std::thread([this, i] { worker_loop(i); });
+    }
+
+    ~ThreadPool() {
+        stop_.store(true, std::memory_order_release);
+        idle_.notify_all();
+        for (auto& w : workers_) w->thread.join();
+        // Anything still queued never ran; free it.
+        Task* task;
+        for (auto& w : workers_)
+            while (w->deque.pop(task)) delete task;
+        for (Task* t : inject_) delete t;
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    std::size_t size() const { return workers_.size(); }
+
+    // Posted tasks that exited with an exception so far.
+    std::size_t failed_tasks() const { return failed_.load(std::memory_order_relaxed); }
+
+    // Fire and forget. An exception escaping f is caught and counted in
+    // failed_tasks() instead of terminating the worker; use submit() to get
+    // it back.
+    template <typename F>
+    void post(F&& f) {
+        enqueue(new FnTask<std::decay_t<F>>(std::forward<F>(f)));
+    }
+
+    // Runs f() on the pool and returns its result through a future.
+    template <typename F>
+    auto submit(F&& f) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+        using R = std::invoke_result_t<std::decay_t<F>>;
+        auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(f));
+        auto fut = task->get_future();
+        post([task] { (*task)(); });
+        return fut;
+    }
+
+    // Calls body(i) for every i in [begin, end), split into chunks of
+    // `grain` indices (default: ~8 chunks per worker). The calling thread
+    // runs pool work while it waits, so nested parallel_for calls from
+    // inside a task do not deadlock. Rethrows the first exception thrown by
+    // body after all chunks have finished.
+    template <typename F>
+    void parallel_for(std::size_t begin, std::size_t end, F&& body, std::size_t grain = 0) {
+        if (begin >= end) return;
+        const std::size_t n = end - begin;
+        if (grain == 0) grain = std::max<std::size_t>(1, n / (size() * 8));
+        const std::size_t chunks = (n + grain - 1) / grain;
+
+        std::atomic<std::size_t> remaining{chunks};
+        std::exception_ptr error;
+        std::mutex error_mtx;
+        for (std::size_t c = 0; c < chunks; ++c) {
+            const std::size_t lo = begin + c * grain;
+            const std::size_t hi = std::min(end, lo + grain);
+            post([&, lo, hi] {
+                try {
+                    for (std::size_t i = lo; i < hi; ++i) body(i);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(error_mtx);
+                    if (!error) error = std::current_exception();
+                }
+                remaining.fetch_sub(1, std::memory_order_release);
+            });
+        }
+        while (remaining.load(std::memory_order_acquire) != 0) {
+            if (!run_one()) std::this_thread::yield();
+        }
+        if (error) std::rethrow_exception(error);
+    }
+
+    // Runs one queued task on the calling thread, if there is one.
+    bool run_one() {
+        Task* task = find_task();
+        if (!task) return false;
+        run_task(task);
+        return true;
+    }
+
+private:
+    struct Task {
+        virtual ~Task() = default;
+        virtual void run() = 0;
+    };
+
+    template <typename F>
+    struct FnTask final : Task {
+        explicit FnTask(F fn) : f(std::move(fn)) {}
+        void run() override { f(); }
+        F f;
+    };
+
+    struct Worker {
+        ChaseLevDeque<Task*> deque;
+        std::thread thread;
+    };
+
+    // Which pool/worker the current thread belongs to, if any.
+    static inline thread_local ThreadPool* tl_pool_ = nullptr;
+    static inline thread_local unsigned tl_index_ = 0;
+
+    void enqueue(Task* task) {
+        if (tl_pool_ == this) {
+            workers_[tl_index_]->deque.push(task);
+        } else {
+            std::lock_guard<std::mutex> lock(inject_mtx_);
+            inject_.push_back(task);
+            inject_size_.store(inject_.size(), std::memory_order_release);
+        }
+        idle_.notify_one();
+    }
+
+    Task* find_task() {
+        Task* task = nullptr;
+        const bool is_worker = tl_pool_ == this;
+        if (is_worker && workers_[tl_index_]->deque.pop(task)) return task;
+        if (inject_size_.load(std::memory_order_acquire) != 0) {
+            std::lock_guard<std::mutex> lock(inject_mtx_);
+            if (!inject_.empty()) {
+                task = inject_.front();
+                inject_.pop_front();
+                inject_size_.store(inject_.size(), std::memory_order_release);
+                return task;
+            }
+        }
+        // Steal, starting from a per-thread pseudo-random victim so thieves
+        // spread out instead of all hammering worker 0.
+        thread_local unsigned seed = static_cast<unsigned>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+        seed = seed * 1103515245u + 12345u;
+        const std::size_t n = workers_.size();
+        const std::size_t start = (seed >> 16) % n;
+        for (std::size_t k = 0; k < n; ++k) {
+            const std::size_t victim = (start + k) % n;
+            if (is_worker && victim == tl_index_) continue;
+            if (workers_[victim]->deque.steal(task)) return task;
+        }
+        return nullptr;
+    }
+
+    void worker_loop(unsigned index) {
+        tl_pool_ = this;
+        tl_index_ = index;
+        for (;;) {
+            Task* task = nullptr;
+            idle_.wait_until([&] { return (task = find_task()) != nullptr || stop_.load(std::memory_order_acquire); },
+                             policy_);
+            if (!task) return;  // stopping and nothing left to do
+            run_task(task);
+        }
+    }
+
+    void run_task(Task* task) {
+        try {
+            task->run();
+        } catch (...) {
+            failed_.fetch_add(1, std::memory_order_relaxed);
+        }
+        delete task;
+    }
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    std::mutex inject_mtx_;
+    std::deque<Task*> inject_;
+    alignas(kCacheLineSize) std::atomic<std::size_t> inject_size_{0};
+
+    std::atomic<bool> stop_{false};
+    std::atomic<std::size_t> failed_{0};
+    WaitPolicy policy_;
+    Parker idle_;
+};
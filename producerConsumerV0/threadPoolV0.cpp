@@ -0,0 +1,154 @@
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <atomic>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <cstdlib>
+
+#include "mutexQueue.h"
+#include "threadPool.h"
+
+// Task throughput: work-stealing ThreadPool vs the v0.cpp design, i.e. N
+// workers popping std::function tasks from one mutex + condition_variable
+// queue (MutexQueue) with notify_one per task.
+//
+// Two workloads:
+//   external  the main thread posts every task (both pools go through one
+//             shared queue; shows the injection cost)
+//   nested    tasks spawn two children down to a fixed depth, like a
+//             divide-and-conquer algorithm (the case work stealing is for)
+
+using Clock = std::chrono::steady_clock;
+
+// The v0.cpp dispatcher, packaged as a pool.
+class GlobalQueuePool {
+public:
+    explicit GlobalQueuePool(unsigned threads) : queue_(std::numeric_limits<std::size_t>::max()) {
+        for (unsigned i = 0; i < threads; ++i)
+            threads_.emplace_back([this] {
+                std::function<void()> task;
+                while (queue_.pop(task)) task();
+            });
+    }
+    ~GlobalQueuePool() {
+        queue_.close();
+        for (auto& t : threads_) t.join();
+    }
+    template <typename F>
+    void post(F&& f) { queue_.push(std::forward<F>(f)); }
+
+private:
+    MutexQueue<std::function<void()>> queue_;
+    std::vector<std::thread> threads_;
+};
+
+// Completion count, striped per thread so the counter itself does not become
+// the shared cache line under test.
+struct alignas(kCacheLineSize) Stripe {
+    std::atomic<long> n{0};
+};
+Stripe done[64];
+std::atomic<unsigned> next_stripe{0};
+
+inline void mark_done() {
+    thread_local unsigned stripe = next_stripe.fetch_add(1) % 64;
+    done[stripe].n.fetch_add(1, std::memory_order_relaxed);
+}
+
+long done_count() {
+    long sum = 0;
+    for (auto& s : done) sum += s.n.load(std::memory_order_relaxed);
+    return sum;
+}
+
+void reset_done() {
+    for (auto& s : done) s.n.store(0);
+}
+
+void wait_for(long total) {
+    while (done_count() < total) std::this_thread::sleep_for(std::chrono::microseconds(50));
+}
+
+inline void work(int spin) {
+    volatile int x = 0;
+    for (int i = 0; i < spin; ++i) x = x + i;
+}
+
+template <typename Pool>
+void spawn(Pool& pool, int depth, int spin) {
+    work(spin);
+    if (depth > 0) {
+        pool.post([&pool, depth, spin] { spawn(pool, depth - 1, spin); });
+        pool.post([&pool, depth, spin] { spawn(pool, depth - 1, spin); });
+    }
+    mark_done();
+}
+
+template <typename Pool>
+double bench_external(Pool& pool, long tasks, int spin) {
+    reset_done();
+    auto start = Clock::now();
+    for (long i = 0; i < tasks; ++i)
+        pool.post([spin] {
+            work(spin);
+            mark_done();
+        });
+    wait_for(tasks);
+    std::chrono::duration<double> secs = Clock::now() - start;
+    return tasks / secs.count();
+}
+
+template <typename Pool>
+double bench_nested(Pool& pool, int depth, int spin) {
+    const long tasks = (2L << depth) - 1;
+    reset_done();
+    auto start = Clock::now();
+    pool.post([&pool, depth, spin] { spawn(pool, depth, spin); });
+    wait_for(tasks);
+    std::chrono::duration<double> secs = Clock::now() - start;
+    return tasks / secs.count();
+}
+
+// ./threadPoolV0 [max_threads] [spin_per_task]
+int main(int argc, char** argv) {
+    unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    const int max_arg = argc > 1 ? std::atoi(argv[1]) : static_cast<int>(hw);
+    int spin = argc > 2 ? std::atoi(argv[2]) : 50;
+    if (max_arg < 1) {
+        std::cerr << "max_threads must be at least 1\n";
+        return 1;
+    }
+    const unsigned max_threads = static_cast<unsigned>(max_arg);
+    const long external_tasks = 500000;
+    const int depth = 18;  // 2^19 - 1 tasks
+
+    {
+        ThreadPool pool(2);
+        auto f = pool.submit([] { return 6 * 7; });
+        std::vector<long> squares(1000);
+        pool.parallel_for(0, squares.size(), [&](std::size_t i) { squares[i] = static_cast<long>(i * i); });
+        std::cout << "submit() -> " << f.get() << ", parallel_for: squares[999] = " << squares[999] << "\n";
+    }
+
+    std::cout << "threads\tworkload\tglobal mutex queue (M tasks/s)\twork stealing (M tasks/s)\n";
+    for (unsigned n = 1;; n = std::min(n * 2, max_threads)) {
+        double g_ext, g_nest, s_ext, s_nest;
+        {
+            GlobalQueuePool pool(n);
+            g_ext = bench_external(pool, external_tasks, spin);
+            g_nest = bench_nested(pool, depth, spin);
+        }
+        {
+            ThreadPool pool(n);
+            s_ext = bench_external(pool, external_tasks, spin);
+            s_nest = bench_nested(pool, depth, spin);
+        }
+        std::cout << n << "\texternal\t" << g_ext / 1e6 << "\t" << s_ext / 1e6 << "\n";
+        std::cout << n << "\tnested\t" << g_nest / 1e6 << "\t" << s_nest / 1e6 << "\n";
+        if (n >= max_threads) break;
+    }
+    return 0;
+}
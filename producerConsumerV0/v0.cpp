@@ -6,15 +6,21 @@
 #include <vector>
 #include <chrono>
 
+#include "../asyncLoggerV0/asyncLogger.h"
+#include "cpuTopology.h"
+#include "idAllocator.h"
+
 const int MAX_BUFFER_SIZE = 10;
 std::queue<int> buffer;
 std::mutex mtx;
 std::condition_variable cv_producer, cv_consumer;
 
 bool stop = false; // 控制标志
-int item_id = 0;
+IdAllocator item_ids(16); // 每个生产者一次预留 16 个 ID，不再共享 ++item_id
 
 void producer(int id) {
+    IdAllocator::Local ids(item_ids);
+
     while (true) {
         std::unique_lock<std::mutex> lock(mtx);
 
@@ -28,9 +34,9 @@ void producer(int id) {
 
         if (stop) break;
 
-        int item = ++item_id;
+        int item = static_cast<int>(ids.next());
         buffer.push(item);
-        std::cout << "[Producer " << id << "] produced: " << item << "\n";
+        alog::log("[Producer {}] produced: {}\n", id, item);  // 异步日志，不在锁内做 I/O
 
         lock.unlock();
         cv_consumer.notify_one();
@@ -38,7 +44,7 @@ void producer(int id) {
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
     }
 
-    std::cout << "[Producer " << id << "] exiting\n";
+    alog::log("[Producer {}] exiting\n", id);
 }
 
 void consumer(int id) {
@@ -55,7 +61,7 @@ void consumer(int id) {
         if (!buffer.empty()) {
             int item = buffer.front();
             buffer.pop();
-            std::cout << "    [Consumer " << id << "] consumed: " << item << "\n";
+            alog::log("    [Consumer {}] consumed: {}\n", id, item);
             lock.unlock();
             cv_producer.notify_one();
         } else {
@@ -65,20 +71,36 @@ void consumer(int id) {
         std::this_thread::sleep_for(std::chrono::milliseconds(150));
     }
 
-    std::cout << "    [Consumer " << id << "] exiting\n";
+    alog::log("    [Consumer {}] exiting\n", id);
 }
 
-int main() {
+// ./v0 [none|pair|compact|spread]   线程绑核策略，见 cpuTopology.h
+int main(int argc, char** argv) {
     const int num_producers = 3;
     const int num_consumers = 3;
 
+    Placement placement = Placement::none;
+    if (argc > 1 && !parse_placement(argv[1], placement)) {
+        std::cerr << "unknown placement " << argv[1] << "\n";
+        return 1;
+    }
+    // 生产者 i 和消费者 i 可以共享 L2/L3，避免队列缓存行跨 socket 来回传递
+    const std::vector<int> cpus =
+        plan_placement(CpuTopology::detect(), placement, num_producers, num_consumers);
+
     std::vector<std::thread> producers, consumers;
 
     for (int i = 0; i < num_producers; ++i)
-        producers.emplace_back(producer, i);
+        producers.emplace_back([&cpus, i] {
+            pin_this_thread(cpus[i]);
+            producer(i);
+        });
 
     for (int i = 0; i < num_consumers; ++i)
-        consumers.emplace_back(consumer, i);
+        consumers.emplace_back([&cpus, i] {
+            pin_this_thread(cpus[num_producers + i]);
+            consumer(i);
+        });
 
     // 运行一段时间后设置 stop = true
     std::this_thread::sleep_for(std::chrono::seconds(5));
@@ -94,6 +116,7 @@ int main() {
     for (auto& p : producers) p.join();
     for (auto& c : consumers) c.join();
 
+    alog::flush();
     std::cout << "All threads exited.\n";
     return 0;
 }
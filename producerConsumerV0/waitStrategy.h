@@ -0,0 +1,138 @@
+#pragma once
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <thread>
+
+#include "cacheLine.h"
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Spin-then-park waiting for the lock-free queues.
+//
+// cv.wait() in v0.cpp goes straight to the kernel. When the queue is only
+// empty/full for a few hundred nanoseconds that is a futex wait + wake and a
+// context switch per item. A waiter here instead goes through three phases:
+//   1. spin   : re-check the condition with a pause hint between checks
+//   2. yield  : re-check, giving the core away between checks
+//   3. park   : register as a waiter and sleep on a futex word
+// and a notifier only makes the wake syscall when someone is registered, so
+// the common "nobody is sleeping" case costs a fence and a load.
+
+// Spinning only helps if the thread we wait for is running on another core.
+inline int default_spin_iterations() {
+    static const int spins = std::thread::hardware_concurrency() > 1 ? 256 : 0;
+    return spins;
+}
+
+struct WaitPolicy {
+    int spin_iterations = default_spin_iterations();  // pause-hinted re-checks before yielding
+    int yield_iterations = 16;  // sched_yield re-checks before parking
+
+    static WaitPolicy park_only() { return {0, 0}; }
+    static WaitPolicy spin_only() { return {INT_MAX, 0}; }
+};
+
+namespace detail {
+
+// `shared` selects the process-shared futex (word lives in a MAP_SHARED
+// mapping and may be waited on from several processes); the default private
+// futex lets the kernel skip the shared-mapping lookup.
+#if defined(__linux__)
+inline void futex_wait(std::atomic<std::uint32_t>& word, std::uint32_t expected, bool shared = false) {
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), shared ? FUTEX_WAIT : FUTEX_WAIT_PRIVATE,
+            expected, nullptr, nullptr, 0);
+}
+
+inline void futex_wake(std::atomic<std::uint32_t>& word, int count, bool shared = false) {
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), shared ? FUTEX_WAKE : FUTEX_WAKE_PRIVATE,
+            count, nullptr, nullptr, 0);
+}
+#else
+// Elsewhere std::atomic::wait is the portable futex (ulock on macOS). It is
+// not specified to work across processes, so shared waiters poll instead.
+inline void futex_wait(std::atomic<std::uint32_t>& word, std::uint32_t expected, bool shared = false) {
+    if (shared) std::this_thread::yield();
+    else word.wait(expected, std::memory_order_acquire);
+}
+
+inline void futex_wake(std::atomic<std::uint32_t>& word, int count, bool shared = false) {
+    if (shared) return;
+    if (count == 1) word.notify_one();
+    else word.notify_all();
+}
+#endif
+
+}  // namespace detail
+
+// One wait point, e.g. "queue not empty". Waiters sleep on `epoch_`; each
+// notification bumps it so a waiter that read the old value cannot miss the
+// wake. `waiters_` lets notify skip the syscall when nobody is parked.
+//
+// The state is plain atomics, so a SharedParker can be placed in shared
+// memory and waited on / notified from different processes.
+template <bool Shared>
+class BasicParker {
+public:
+    // Waits until `ready()` returns true. `ready` may perform the operation
+    // itself (e.g. try_pop) so that success and the check are one step.
+    template <typename Pred>
+    void wait_until(Pred&& ready, const WaitPolicy& policy) {
+        for (int i = 0; i < policy.spin_iterations; ++i) {
+            if (ready()) return;
+            cpu_relax();
+        }
+        for (int i = 0; i < policy.yield_iterations; ++i) {
+            if (ready()) return;
+            std::this_thread::yield();
+        }
+        for (;;) {
+            const std::uint32_t epoch = epoch_.load(std::memory_order_acquire);
+            waiters_.fetch_add(1, std::memory_order_seq_cst);
+            // Pairs with the fence in notify: either we see the new state, or
+            // the notifier sees our registration.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (ready()) {
+                waiters_.fetch_sub(1, std::memory_order_relaxed);
+                return;
+            }
+            detail::futex_wait(epoch_, epoch, Shared);
+            waiters_.fetch_sub(1, std::memory_order_relaxed);
+            if (ready()) return;
+        }
+    }
+
+    void notify_one() { notify(1); }
+    void notify_all() { notify(INT_MAX); }
+
+    int waiters() const { return static_cast<int>(waiters_.load(std::memory_order_relaxed)); }
+
+    // notify_one/notify_all calls so far, and how many of them found a
+    // parked waiter and made the wake syscall.
+    std::uint64_t notifies() const { return notifies_.load(std::memory_order_relaxed); }
+    std::uint64_t wakes() const { return wakes_.load(std::memory_order_relaxed); }
+
+private:
+    void notify(int count) {
+        notifies_.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_relaxed) == 0) return;
+        wakes_.fetch_add(1, std::memory_order_relaxed);
+        epoch_.fetch_add(1, std::memory_order_release);
+        detail::futex_wake(epoch_, count, Shared);
+    }
+
+    alignas(kCacheLineSize) std::atomic<std::uint32_t> epoch_{0};
+    std::atomic<std::uint32_t> waiters_{0};
+    // Written by notifiers only; kept off the line the waiters poll.
+    alignas(kCacheLineSize) std::atomic<std::uint64_t> notifies_{0};
+    std::atomic<std::uint64_t> wakes_{0};
+};
+
+using Parker = BasicParker<false>;
+using SharedParker = BasicParker<true>;
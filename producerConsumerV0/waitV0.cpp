@@ -0,0 +1,80 @@
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+#include "mpmcQueue.h"
+#include "mutexQueue.h"
+
+// Wakeup latency: how long after a push does a waiting consumer see the item?
+//
+// One producer pushes a timestamp, then busy-waits `gap_us` so the consumer
+// has drained the queue and gone back to waiting before the next item. The
+// consumer records now - timestamp. With cv.wait (the v0.cpp path) every item
+// pays a futex wake + context switch; with spin-then-park the consumer is
+// usually still spinning when the item lands.
+
+using Clock = std::chrono::steady_clock;
+
+std::int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+template <typename Queue>
+std::vector<std::int64_t> measure(Queue& q, int samples, int gap_us) {
+    std::vector<std::int64_t> latencies;
+    latencies.reserve(samples);
+
+    std::thread c([&] {
+        std::int64_t sent;
+        while (q.pop(sent)) latencies.push_back(now_ns() - sent);
+    });
+    for (int i = 0; i < samples; ++i) {
+        auto until = Clock::now() + std::chrono::microseconds(gap_us);
+        while (Clock::now() < until) {
+        }
+        q.push(now_ns());
+    }
+    q.close();
+    c.join();
+    return latencies;
+}
+
+void report(const char* name, std::vector<std::int64_t> lat) {
+    std::sort(lat.begin(), lat.end());
+    auto pct = [&](double p) { return lat[std::min(lat.size() - 1, static_cast<std::size_t>(p * lat.size()))]; };
+    std::cout << name << "\tp50 " << pct(0.50) << " ns\tp99 " << pct(0.99) << " ns\tp99.9 " << pct(0.999)
+              << " ns\tmax " << lat.back() << " ns\n";
+}
+
+// ./waitV0 [samples] [gap_us] [spin_iterations]
+int main(int argc, char** argv) {
+    int samples = argc > 1 ? std::atoi(argv[1]) : 20000;
+    int gap_us = argc > 2 ? std::atoi(argv[2]) : 20;
+    WaitPolicy adaptive;
+    if (argc > 3) adaptive.spin_iterations = std::atoi(argv[3]);
+    if (samples < 1 || gap_us < 0) {
+        std::cerr << "samples must be at least 1 and gap_us not negative\n";
+        return 1;
+    }
+
+    std::cout << samples << " samples, " << gap_us << " us between items, spin "
+              << adaptive.spin_iterations << " / yield " << adaptive.yield_iterations << "\n";
+
+    {
+        MutexQueue<std::int64_t> q(1024);
+        report("mutex+cv    ", measure(q, samples, gap_us));
+    }
+    {
+        MpmcQueue<std::int64_t> q(1024, WaitPolicy::park_only());
+        report("park only   ", measure(q, samples, gap_us));
+    }
+    {
+        MpmcQueue<std::int64_t> q(1024, adaptive);
+        report("spin+park   ", measure(q, samples, gap_us));
+    }
+    return 0;
+}